@@ -2,10 +2,29 @@ import sys, os
 import argparse
 import subprocess
 import glob
+import shutil
 from textwrap import dedent
 import chevron
 import json
 import pickle
+import time
+
+def read_header(benchfile):
+    # The first line is `// name: WHICH, ...`; the second is `// N, ...`.
+    with open(benchfile, 'r') as f:
+        firstline = f.readline()
+        secondline = f.readline()
+
+    assert firstline.startswith('//')
+    assert secondline.startswith('//')
+    firstline = firstline[2:]
+    secondline = secondline[2:]
+
+    name, firstline = firstline.split(':', maxsplit=1)
+    whichs = [s.strip() for s in firstline.split(',')]
+    ns = [int(s.strip()) for s in secondline.split(',')]
+    return name.strip(), whichs, ns
+
 
 def generate(args):
     benchmarks = glob.glob(os.path.join(args.dir, '**.bench'))
@@ -32,6 +51,7 @@ def generate(args):
                         --generated-file ${{BenchGeneratedFile}}
                         --build-target ${{BenchCompileTarget}}
                         --clean-target ${{BenchCleanTarget}}
+                        --samples ${{BUILDBENCH_SAMPLES}}
                     DEPENDS
                         "{os.path.abspath(__file__)}"
                         "${{benchf}}"
@@ -42,27 +62,49 @@ def generate(args):
             endforeach()
 
             set_property(TARGET buildbench APPEND PROPERTY BUILDBENCH_BENCHMARKS buildbench-${{name}})
+
+            add_custom_target(buildbench-matrix-${{name}}
+                COMMAND "{sys.executable}" "{os.path.abspath(__file__)}" matrix
+                    ${{name}} "${{WHICHS}}" ${{benchf}}
+                    --ns "${{NS}}"
+                    --compilers "${{BUILDBENCH_COMPILERS}}"
+                    --standards "${{BUILDBENCH_STANDARDS}}"
+                    --include-dirs "${{BUILDBENCH_INCLUDE_DIRS}}"
+                    --workingdir ${{CMAKE_CURRENT_BINARY_DIR}}/buildbench
+                    --samples ${{BUILDBENCH_SAMPLES}}
+                DEPENDS
+                    "{os.path.abspath(__file__)}"
+                    "${{benchf}}"
+                COMMENT "Running benchmark ${{name}} for each compiler and standard"
+                VERBATIM
+                USES_TERMINAL
+            )
+            set_property(TARGET buildbench-matrix APPEND PROPERTY BUILDBENCH_BENCHMARKS buildbench-matrix-${{name}})
+
+            add_custom_target(buildbench-symbols-${{name}}
+                COMMAND "{sys.executable}" "{os.path.abspath(__file__)}" symbols
+                    ${{name}} "${{WHICHS}}" ${{benchf}}
+                    --ns "${{NS}}"
+                    --compiler ${{CMAKE_CXX_COMPILER}}
+                    --include-dirs "${{BUILDBENCH_INCLUDE_DIRS}}"
+                    --workingdir ${{CMAKE_CURRENT_BINARY_DIR}}/buildbench
+                DEPENDS
+                    "{os.path.abspath(__file__)}"
+                    "${{benchf}}"
+                COMMENT "Measuring the symbols of benchmark ${{name}}"
+                VERBATIM
+                USES_TERMINAL
+            )
+            set_property(TARGET buildbench-symbols APPEND PROPERTY BUILDBENCH_BENCHMARKS buildbench-symbols-${{name}})
             set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${{benchf}})
         endfunction()
     '''))
 
     for benchmark in benchmarks:
-        with open(benchmark, 'r') as f:
-            firstline = f.readline()
-            secondline = f.readline()
-
-        assert firstline.startswith('//')
-        assert secondline.startswith('//')
-        firstline = firstline[2:]
-        secondline = secondline[2:]
-
-        name, firstline = firstline.split(':', maxsplit=1)
-        whichs = [s.strip() for s in firstline.split(',')]
+        name, whichs, ns = read_header(benchmark)
         whichs = ';'.join(whichs)
-
-        ns = [s.strip() for s in secondline.split(',')]
-        ns = ','.join(ns)
-        print(f'add_benchmark({name.strip()} "{os.path.abspath(benchmark)}" "{whichs}" "{ns}")')
+        ns = ','.join(str(n) for n in ns)
+        print(f'add_benchmark({name} "{os.path.abspath(benchmark)}" "{whichs}" "{ns}")')
 
 
 def evaluate_template(benchtempl, outputfile, context, m, n):
@@ -84,47 +126,36 @@ def estimate_runtime(measure, benchtempl, outputfile, context, n):
     return baseeval['time']
 
 
-def run(args):
-    CMAKE_COMMAND = args.cmake
-    CMAKE_BINARY_DIR = args.cmake_binary_dir
-
-    cmake_build_target = [CMAKE_COMMAND, '--build', CMAKE_BINARY_DIR, '--target', args.build_target]
-    cmake_clean_target = [CMAKE_COMMAND, '--build', CMAKE_BINARY_DIR, '--target', args.clean_target]
-
-    runner_py = os.path.abspath(os.path.join(os.path.dirname(__file__), 'runner.py'))
-    runner = [sys.executable, runner_py, '--timeout', str(args.timeout), '--', *cmake_build_target]
-
-    def measure(m, n):
-        res = subprocess.run(runner, capture_output=True)
-        if res.returncode != 0:
-            print(res.stderr.decode('utf-8'), file=sys.stderr)
-        res.check_returncode()
-        subprocess.run(cmake_clean_target, stdout=subprocess.DEVNULL).check_returncode()
-        results = json.loads(res.stdout)
-
-        time = results['time'] / m
-        time = time
-        mem = round(results['memory'] / m)
-        results = { 'm': m, 'n': n, 'time': time, 'memory': mem }
+def measure_samples(measure, samples, m, n):
+    # With several samples, time and memory are the means; the samples are kept for error bars.
+    if samples <= 1:
+        return measure(m, n)
 
-        return results
+    measured = [measure(m, n) for _ in range(samples)]
+    return {
+        'm': m,
+        'n': n,
+        'time': sum(x['time'] for x in measured) / samples,
+        'memory': round(sum(x['memory'] for x in measured) / samples),
+        'samples': [{'time': x['time'], 'memory': x['memory']} for x in measured],
+    }
 
-    ns = [int(x) for x in args.ns.split(',')]
 
+def sweep(name, which, benchfile, generated_file, ns, measure, samples=1):
     bench_results = {
-        'name': args.bench,
-        'which': args.which,
+        'name': name,
+        'which': which,
         'results': [],
     }
 
     print(dedent(f'''\
     {{
-        "name": "{args.bench}",
-        "which": "{args.which}",
+        "name": "{name}",
+        "which": "{which}",
         "results": ['''))
 
     for n in ns:
-        esttime = estimate_runtime(measure, args.benchfile, args.generated_file, context={args.which: True}, n=n)
+        esttime = estimate_runtime(measure, benchfile, generated_file, context={which: True}, n=n)
 
         MAX_EST_TIME = 2.0
         MAX_EST_M = int(MAX_EST_TIME / esttime)
@@ -133,11 +164,11 @@ def run(args):
 
         M = max(MIN_M, min(MAX_EST_M, MAX_M))
 
-        evaluate_template(args.benchfile, args.generated_file, context={args.which: True}, m=M, n=n)
-        results = measure(M, n)
+        evaluate_template(benchfile, generated_file, context={which: True}, m=M, n=n)
+        results = measure_samples(measure, samples, M, n)
 
-        evaluate_template(args.benchfile, args.generated_file, context={args.which: True, 'BASELINE': True}, m=M, n=n)
-        baseline_results = measure(M, n)
+        evaluate_template(benchfile, generated_file, context={which: True, 'BASELINE': True}, m=M, n=n)
+        baseline_results = measure_samples(measure, samples, M, n)
         results['baseline'] = baseline_results
         bench_results['results'].append(results)
 
@@ -150,19 +181,288 @@ def run(args):
         ]
     }}'''))
 
+    return bench_results
+
+
+def make_measure(runner, clean=None):
+    def measure(m, n):
+        res = subprocess.run(runner, capture_output=True)
+        if res.returncode != 0:
+            print(res.stderr.decode('utf-8'), file=sys.stderr)
+        res.check_returncode()
+        if clean is not None:
+            clean()
+        results = json.loads(res.stdout)
+
+        time = results['time'] / m
+        mem = round(results['memory'] / m)
+        results = { 'm': m, 'n': n, 'time': time, 'memory': mem }
+
+        return results
+
+    return measure
+
+
+def runner_command(timeout, cmd):
+    runner_py = os.path.abspath(os.path.join(os.path.dirname(__file__), 'runner.py'))
+    return [sys.executable, runner_py, '--timeout', str(timeout), '--', *cmd]
+
+
+def load_results(path):
+    if os.path.exists(path):
+        with open(path, 'rb') as f:
+            return pickle.load(f)
+    return dict()
+
+
+def save_results(path, results):
+    with open(path, 'wb') as f:
+        pickle.dump(results, file=f)
+
+
+def run(args):
+    CMAKE_COMMAND = args.cmake
+    CMAKE_BINARY_DIR = args.cmake_binary_dir
+
+    cmake_build_target = [CMAKE_COMMAND, '--build', CMAKE_BINARY_DIR, '--target', args.build_target]
+    cmake_clean_target = [CMAKE_COMMAND, '--build', CMAKE_BINARY_DIR, '--target', args.clean_target]
+
+    def clean():
+        subprocess.run(cmake_clean_target, stdout=subprocess.DEVNULL).check_returncode()
+
+    measure = make_measure(runner_command(args.timeout, cmake_build_target), clean)
+    ns = [int(x) for x in args.ns.split(',')]
+
+    bench_results = sweep(args.bench, args.which, args.benchfile, args.generated_file, ns, measure,
+        args.samples)
+
     cumulative_results_f = os.path.join(args.workingdir, 'bench.results.pickle')
-    if os.path.exists(cumulative_results_f):
-        with open(cumulative_results_f, 'rb') as f:
-            cumulative_results = pickle.load(f)
-    else:
-        cumulative_results = dict()
+    cumulative_results = load_results(cumulative_results_f)
 
     if args.bench not in cumulative_results:
         cumulative_results[args.bench] = dict()
     
     cumulative_results[args.bench][args.which] = bench_results
-    with open(cumulative_results_f, 'wb') as f:
-        pickle.dump(cumulative_results, file=f)
+    save_results(cumulative_results_f, cumulative_results)
+
+
+def is_msvc_like(compiler):
+    name = os.path.splitext(os.path.basename(compiler))[0].lower()
+    return name in ('cl', 'clang-cl') or name.startswith('clang-cl-')
+
+
+def compiler_version(compiler):
+    if is_msvc_like(compiler):
+        res = subprocess.run([compiler, '--version'], capture_output=True, text=True)
+        output = (res.stdout or res.stderr).strip().splitlines()
+        return output[0] if output else 'unknown'
+
+    res = subprocess.run([compiler, '-dumpversion'], capture_output=True, text=True)
+    return res.stdout.strip() or 'unknown'
+
+
+def compile_command(compiler, std, include_dirs, source, output):
+    if is_msvc_like(compiler):
+        return [compiler, '/nologo', '/EHsc', f'/std:c++{std}', '/c', source, f'/Fo{output}',
+            *[f'/I{d}' for d in include_dirs]]
+
+    return [compiler, f'-std=c++{std}', '-c', source, '-o', output,
+        *[f'-I{d}' for d in include_dirs]]
+
+
+def matrix(args):
+    compilers = [c for c in args.compilers.replace(',', ';').split(';') if c]
+    standards = [s for s in args.standards.replace(',', ';').split(';') if s]
+    include_dirs = [d for d in args.include_dirs.split(';') if d]
+    whichs = [w for w in args.whichs.replace(',', ';').split(';') if w]
+    ns = [int(x) for x in args.ns.split(',')]
+
+    workingdir = os.path.join(args.workingdir, 'matrix')
+    os.makedirs(workingdir, exist_ok=True)
+    generated_file = os.path.join(workingdir, 'bench.cpp')
+    object_file = os.path.join(workingdir, 'bench.o')
+
+    results_f = os.path.join(args.workingdir, 'bench.matrix.pickle')
+    results = load_results(results_f)
+    bench = results.setdefault(args.bench, dict())
+
+    for compiler in compilers:
+        if shutil.which(compiler) is None:
+            print(f'Skipping {compiler}: not found', file=sys.stderr)
+            continue
+
+        version = compiler_version(compiler)
+        for std in standards:
+            # Results are keyed by toolchain: the compiler, its version, and the standard.
+            toolchain = f'{os.path.basename(compiler)} {version} c++{std}'
+            cmd = compile_command(compiler, std, include_dirs, generated_file, object_file)
+            measure = make_measure(runner_command(args.timeout, cmd))
+
+            toolchain_results = bench.setdefault(toolchain, {
+                'compiler': compiler,
+                'version': version,
+                'std': std,
+                'whichs': dict(),
+            })
+
+            for which in whichs:
+                print(f'{args.bench} {which}: {toolchain}', file=sys.stderr)
+                try:
+                    which_results = sweep(args.bench, which, args.benchfile, generated_file, ns, measure,
+                        args.samples)
+                except (subprocess.CalledProcessError, subprocess.TimeoutExpired) as e:
+                    # E.g. a standard which this compiler does not support.
+                    print(f'Skipping {which} for {toolchain}: {e}', file=sys.stderr)
+                    continue
+
+                toolchain_results['whichs'][which] = which_results
+                save_results(results_f, results)
+
+
+def section_size(size_tool, object_file, section):
+    # `size -A` prints one `name size address` line per section.
+    res = subprocess.run([size_tool, '-A', object_file], capture_output=True, text=True)
+    res.check_returncode()
+    for line in res.stdout.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0] == section:
+            return int(fields[1])
+    return 0
+
+
+def measure_symbols(args, compile_cmd, object_file):
+    subprocess.run(compile_cmd, check=True, timeout=args.timeout)
+
+    res = subprocess.run([args.nm, '--defined-only', object_file], capture_output=True, text=True)
+    res.check_returncode()
+    # Each line is `address type name`; the names are mangled, which is what the object stores.
+    names = [line.split()[-1] for line in res.stdout.splitlines() if line.strip()]
+
+    return {
+        'object': os.path.getsize(object_file),
+        'debug_info': section_size(args.size, object_file, '.debug_info'),
+        'symbols': len(names),
+        'longest': max((len(name) for name in names), default=0),
+        'total': sum(len(name) for name in names),
+    }
+
+
+SYMBOL_COLUMNS = ['object', 'debug_info', 'symbols', 'longest', 'total']
+
+
+def symbols(args):
+    include_dirs = [d for d in args.include_dirs.split(';') if d]
+    whichs = [w for w in args.whichs.replace(',', ';').split(';') if w]
+    ns = [int(x) for x in args.ns.split(',')]
+
+    workingdir = os.path.join(args.workingdir, 'symbols')
+    os.makedirs(workingdir, exist_ok=True)
+    generated_file = os.path.join(workingdir, 'bench.cpp')
+    object_file = os.path.join(workingdir, 'bench.o')
+
+    compile_cmd = [args.compiler, f'-std=c++{args.std}', '-g', '-c', generated_file, '-o', object_file,
+        *[f'-I{d}' for d in include_dirs]]
+
+    results_f = os.path.join(args.workingdir, 'bench.symbols.pickle')
+    results = load_results(results_f)
+    bench = results.setdefault(args.bench, dict())
+
+    print(f'# {args.bench}')
+    print('| Which | N | ' + ' | '.join(SYMBOL_COLUMNS) + ' |')
+    print('|---' * (len(SYMBOL_COLUMNS) + 2) + '|')
+
+    for which in whichs:
+        which_results = []
+        for n in ns:
+            evaluate_template(args.benchfile, generated_file, context={which: True}, m=args.m, n=n)
+            try:
+                result = measure_symbols(args, compile_cmd, object_file)
+            except (subprocess.CalledProcessError, subprocess.TimeoutExpired) as e:
+                print(f'Skipping {which} N={n}: {e}', file=sys.stderr)
+                continue
+
+            evaluate_template(args.benchfile, generated_file, context={which: True, 'BASELINE': True},
+                m=args.m, n=n)
+            result['baseline'] = measure_symbols(args, compile_cmd, object_file)
+            result.update({'m': args.m, 'n': n})
+            which_results.append(result)
+
+            print(f'| {which} | {n} | ' + ' | '.join(str(result[c]) for c in SYMBOL_COLUMNS) + ' |')
+
+        bench[which] = {'name': args.bench, 'which': which, 'results': which_results}
+        save_results(results_f, results)
+
+
+def timed(cmd, timeout):
+    start = time.perf_counter()
+    subprocess.run(cmd, check=True, timeout=timeout, stdout=subprocess.DEVNULL)
+    return time.perf_counter() - start
+
+
+def measure_multitu(args, compile_cmd, link_cmd, context, m, n):
+    # Each translation unit is rendered with its index as `tu`; the first one is also MAIN.
+    objects = []
+    compile_time = 0.0
+    for tu in range(args.tus):
+        source = os.path.join(args.workingdir, 'multitu', f'tu{tu}.cpp')
+        output = os.path.join(args.workingdir, 'multitu', f'tu{tu}.o')
+        evaluate_template(args.benchfile, source, context={**context, 'tu': tu, 'MAIN': tu == 0},
+            m=m, n=n)
+        compile_time += timed(compile_cmd(source, output), args.timeout)
+        objects.append(output)
+
+    link_time = timed(link_cmd(objects), args.timeout)
+    return {'compile': compile_time, 'link': link_time, 'total': compile_time + link_time}
+
+
+MULTITU_COLUMNS = ['compile', 'link', 'total']
+
+
+def multitu(args):
+    name, whichs, ns = read_header(args.benchfile)
+    if args.whichs:
+        whichs = [w for w in args.whichs.replace(',', ';').split(';') if w]
+    if args.ns:
+        ns = [int(x) for x in args.ns.split(',')]
+    include_dirs = [d for d in args.include_dirs.split(';') if d]
+
+    os.makedirs(os.path.join(args.workingdir, 'multitu'), exist_ok=True)
+    executable = os.path.join(args.workingdir, 'multitu', 'bench')
+
+    def compile_cmd(source, output):
+        return [args.compiler, f'-std=c++{args.std}', *args.flags.split(), '-c', source, '-o', output,
+            *[f'-I{d}' for d in include_dirs]]
+
+    def link_cmd(objects):
+        return [args.compiler, *objects, '-o', executable]
+
+    results_f = os.path.join(args.workingdir, 'bench.multitu.pickle')
+    results = load_results(results_f)
+    bench = results.setdefault(name, dict())
+
+    print(f'# {name} ({args.tus} translation units, seconds)')
+    print('| Which | N | ' + ' | '.join(MULTITU_COLUMNS) + ' | baseline total |')
+    print('|---' * (len(MULTITU_COLUMNS) + 3) + '|')
+
+    for which in whichs:
+        which_results = []
+        for n in ns:
+            try:
+                result = measure_multitu(args, compile_cmd, link_cmd, {which: True}, args.m, n)
+                result['baseline'] = measure_multitu(args, compile_cmd, link_cmd,
+                    {which: True, 'BASELINE': True}, args.m, n)
+            except (subprocess.CalledProcessError, subprocess.TimeoutExpired) as e:
+                print(f'Skipping {which} N={n}: {e}', file=sys.stderr)
+                continue
+
+            result.update({'m': args.m, 'n': n, 'tus': args.tus})
+            which_results.append(result)
+            print(f'| {which} | {n} | ' + ' | '.join(f'{result[c]:.3f}' for c in MULTITU_COLUMNS)
+                + f' | {result["baseline"]["total"]:.3f} |')
+
+        bench[which] = {'name': name, 'which': which, 'results': which_results}
+        save_results(results_f, results)
+
 
 if __name__ == '__main__':
     parser = argparse.ArgumentParser(description='manage the benchmarks')
@@ -187,8 +487,56 @@ if __name__ == '__main__':
     run_p.add_argument('--clean-target', required=True, help='The CMake target which will clean the benchmark')
     run_p.add_argument('--keep-temps', action='store_true', help='Whether to keep the generated .cpp files')
     run_p.add_argument('--timeout', default=100, type=int, help='The amount of seconds before timing out a benchmark')
+    run_p.add_argument('--samples', default=1, type=int, help='How many times to measure each N')
     run_p.set_defaults(func=run)
 
+    matrix_p = sp.add_parser('matrix', help='Run a benchmark against several compilers and standards')
+    matrix_p.add_argument('bench', help='The name of the benchmark')
+    matrix_p.add_argument('whichs', help='The benchmark configurations (;-separated)')
+    matrix_p.add_argument('benchfile', help='The file which constitutes the benchmark')
+    matrix_p.add_argument('--ns', required=True, help='What N values to use')
+    matrix_p.add_argument('--compilers', required=True, help='The compilers to use (;-separated)')
+    matrix_p.add_argument('--standards', default='14;17;20', help='The C++ standards to use (;-separated)')
+    matrix_p.add_argument('--include-dirs', default='', help='Include directories (;-separated)')
+    matrix_p.add_argument('--workingdir', required=True, help='Where to generate the benchmark info')
+    matrix_p.add_argument('-o', '--output', help='The file to output to (defaults to stdout)')
+    matrix_p.add_argument('--timeout', default=100, type=int, help='The amount of seconds before timing out a benchmark')
+    matrix_p.add_argument('--samples', default=1, type=int, help='How many times to measure each N')
+    matrix_p.set_defaults(func=matrix)
+
+    symbols_p = sp.add_parser('symbols',
+        help='Measure the object size, debug info, and mangled symbols of a benchmark')
+    symbols_p.add_argument('bench', help='The name of the benchmark')
+    symbols_p.add_argument('whichs', help='The benchmark configurations (;-separated)')
+    symbols_p.add_argument('benchfile', help='The file which constitutes the benchmark')
+    symbols_p.add_argument('--ns', required=True, help='What N values to use')
+    symbols_p.add_argument('--m', default=10, type=int, help='What M value to use')
+    symbols_p.add_argument('--compiler', default='c++', help='The compiler to use (GCC-like)')
+    symbols_p.add_argument('--std', default='17', help='The C++ standard to use')
+    symbols_p.add_argument('--nm', default='nm', help='The nm tool to list the symbols with')
+    symbols_p.add_argument('--size', default='size', help='The size tool to read the section sizes with')
+    symbols_p.add_argument('--include-dirs', default='', help='Include directories (;-separated)')
+    symbols_p.add_argument('--workingdir', required=True, help='Where to generate the benchmark info')
+    symbols_p.add_argument('-o', '--output', help='The file to output to (defaults to stdout)')
+    symbols_p.add_argument('--timeout', default=100, type=int, help='The amount of seconds before timing out a benchmark')
+    symbols_p.set_defaults(func=symbols)
+
+    multitu_p = sp.add_parser('multitu',
+        help='Measure the total compile and link time of a benchmark split over several translation units')
+    multitu_p.add_argument('benchfile', help='The file which constitutes the benchmark')
+    multitu_p.add_argument('--whichs', default='', help='The benchmark configurations (;-separated; defaults to all)')
+    multitu_p.add_argument('--ns', default='', help='What N values to use (defaults to those in the file)')
+    multitu_p.add_argument('--m', default=10, type=int, help='What M value to use')
+    multitu_p.add_argument('--tus', default=8, type=int, help='How many translation units to build')
+    multitu_p.add_argument('--compiler', default='c++', help='The compiler to use (GCC-like)')
+    multitu_p.add_argument('--std', default='17', help='The C++ standard to use')
+    multitu_p.add_argument('--flags', default='', help='Extra compiler flags (space-separated)')
+    multitu_p.add_argument('--include-dirs', default='', help='Include directories (;-separated)')
+    multitu_p.add_argument('--workingdir', required=True, help='Where to generate the benchmark info')
+    multitu_p.add_argument('-o', '--output', help='The file to output to (defaults to stdout)')
+    multitu_p.add_argument('--timeout', default=100, type=int, help='The amount of seconds before timing out a benchmark')
+    multitu_p.set_defaults(func=multitu)
+
     args = parser.parse_args()
     func = args.func
     del args.func
@@ -0,0 +1,203 @@
+import argparse
+import html
+import json
+import math
+import os
+import pickle
+
+# Empirical complexity of the buildbench results.
+#
+# Each curve (baseline-subtracted time or memory against N) is fitted to every model below as
+# y = a + b * f(N), by least squares. The best model is the one with the lowest residual, but a
+# simpler model wins unless a more complex one is clearly better. Independently, y = c * N^k is
+# fitted on a log-log scale, which gives the "exponent" of the curve.
+
+MODELS = [
+    ('O(1)', lambda n: 0.0),
+    ('O(N)', lambda n: n),
+    ('O(N log N)', lambda n: n * math.log(n) if n > 1 else 0.0),
+    ('O(N^2)', lambda n: n * n),
+]
+
+# A more complex model must reduce the residual by this factor to be preferred.
+SIMPLER_MODEL_SLACK = 0.75
+
+METRICS = {
+    'time': ('ms', lambda x: (x['time'] - x['baseline']['time']) * 1e3),
+    'memory': ('MB', lambda x: (x['memory'] - x['baseline']['memory']) / 1e3),
+}
+
+
+def fit_linear(xs, ys):
+    # Least squares for y = a + b * x
+    count = len(xs)
+    mean_x = sum(xs) / count
+    mean_y = sum(ys) / count
+    var_x = sum((x - mean_x) ** 2 for x in xs)
+    if var_x == 0:
+        return mean_y, 0.0
+    b = sum((x - mean_x) * (y - mean_y) for x, y in zip(xs, ys)) / var_x
+    return mean_y - b * mean_x, b
+
+
+def fit_model(f, ns, ys):
+    xs = [f(n) for n in ns]
+    a, b = fit_linear(xs, ys)
+    rss = sum((y - (a + b * x)) ** 2 for x, y in zip(xs, ys))
+    return {'constant': a, 'coefficient': b, 'rss': rss}
+
+
+def fit_exponent(ns, ys):
+    # log y = log c + k log N, over the points where both are positive.
+    points = [(math.log(n), math.log(y)) for n, y in zip(ns, ys) if n > 0 and y > 0]
+    if len(points) < 2:
+        return None
+    log_c, k = fit_linear([p[0] for p in points], [p[1] for p in points])
+    return {'exponent': k, 'constant': math.exp(log_c)}
+
+
+def fit_curve(ns, ys):
+    fits = {name: fit_model(f, ns, ys) for name, f in MODELS}
+
+    best = MODELS[0][0]
+    for name, _ in MODELS[1:]:
+        # Models which decrease with N are not meaningful here.
+        if fits[name]['coefficient'] <= 0:
+            continue
+        if fits[name]['rss'] < fits[best]['rss'] * SIMPLER_MODEL_SLACK:
+            best = name
+
+    return {
+        'best': best,
+        'models': fits,
+        'power_law': fit_exponent(ns, ys),
+    }
+
+
+def analyze(results):
+    # results[benchmark][which]['results'] -> summary[benchmark][which][metric]
+    summary = dict()
+    for benchmark, bench_results in results.items():
+        for which, which_results in bench_results.items():
+            points = which_results['results']
+            if len(points) < 3:
+                continue
+            ns = [x['n'] for x in points]
+            for metric, (unit, value) in METRICS.items():
+                fit = fit_curve(ns, [value(x) for x in points])
+                fit['unit'] = unit
+                summary.setdefault(benchmark, dict()).setdefault(which, dict())[metric] = fit
+    return summary
+
+
+def flatten_matrix(matrix):
+    # Turns results[benchmark][toolchain]['whichs'][which] into results[benchmark]['which @ toolchain']
+    results = dict()
+    for benchmark, bench_results in matrix.items():
+        for toolchain, toolchain_results in bench_results.items():
+            for which, which_results in toolchain_results['whichs'].items():
+                results.setdefault(benchmark, dict())[f'{which} @ {toolchain}'] = which_results
+    return results
+
+
+def rows(summary):
+    for benchmark, bench_summary in sorted(summary.items()):
+        for which, which_summary in sorted(bench_summary.items()):
+            for metric, fit in which_summary.items():
+                best = fit['models'][fit['best']]
+                power = fit['power_law']
+                yield {
+                    'benchmark': benchmark,
+                    'which': which,
+                    'metric': metric,
+                    'best': fit['best'],
+                    'coefficient': f'{best["coefficient"]:.4g} {fit["unit"]}',
+                    'constant': f'{best["constant"]:.4g} {fit["unit"]}',
+                    'exponent': '-' if power is None else f'{power["exponent"]:.2f}',
+                }
+
+
+COLUMNS = [
+    ('benchmark', 'Benchmark'),
+    ('which', 'Which'),
+    ('metric', 'Metric'),
+    ('best', 'Best fit'),
+    ('coefficient', 'Coefficient'),
+    ('constant', 'Constant'),
+    ('exponent', 'Exponent (N^k)'),
+]
+
+
+def markdown_report(summary):
+    lines = [
+        '# Buildbench complexity',
+        '',
+        'Each curve is fitted as `a + b * f(N)`; "Coefficient" is `b` and "Constant" is `a` for the best fit.',
+        '"Exponent" is `k` from fitting `c * N^k`.',
+        '',
+        '| ' + ' | '.join(title for _, title in COLUMNS) + ' |',
+        '|---' * len(COLUMNS) + '|',
+    ]
+    for row in rows(summary):
+        lines.append('| ' + ' | '.join(row[key] for key, _ in COLUMNS) + ' |')
+    return '\n'.join(lines) + '\n'
+
+
+def html_report(summary):
+    header = ''.join(f'<th>{html.escape(title)}</th>' for _, title in COLUMNS)
+    body = '\n'.join(
+        '<tr>' + ''.join(f'<td>{html.escape(row[key])}</td>' for key, _ in COLUMNS) + '</tr>'
+        for row in rows(summary))
+    return f'''<!DOCTYPE html>
+<html>
+<head>
+<meta charset="utf-8">
+<title>Buildbench complexity</title>
+<style>
+table {{ border-collapse: collapse; }}
+th, td {{ border: 1px solid #ccc; padding: 0.25em 0.5em; }}
+</style>
+</head>
+<body>
+<h1>Buildbench complexity</h1>
+<p>Each curve is fitted as a + b * f(N); "Coefficient" is b and "Constant" is a for the best fit.
+"Exponent" is k from fitting c * N^k.</p>
+<table>
+<tr>{header}</tr>
+{body}
+</table>
+</body>
+</html>
+'''
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Fit the buildbench results to complexity classes')
+    parser.add_argument('results', nargs='?', help='The results file to load')
+    parser.add_argument('--matrix', help='A compiler matrix results file (from `bench.py matrix`) to load')
+    parser.add_argument('-o', '--output-dir', required=True, help='Where to write the summary and reports')
+
+    args = parser.parse_args()
+    if args.results is None and args.matrix is None:
+        parser.error('expected a results file or --matrix')
+
+    results = dict()
+    if args.results is not None:
+        with open(args.results, 'rb') as f:
+            results.update(pickle.load(f))
+    if args.matrix is not None:
+        with open(args.matrix, 'rb') as f:
+            for benchmark, bench_results in flatten_matrix(pickle.load(f)).items():
+                results.setdefault(benchmark, dict()).update(bench_results)
+
+    summary = analyze(results)
+
+    os.makedirs(args.output_dir, exist_ok=True)
+    with open(os.path.join(args.output_dir, 'complexity.json'), 'w') as f:
+        json.dump(summary, f, indent=2)
+    with open(os.path.join(args.output_dir, 'complexity.md'), 'w') as f:
+        f.write(markdown_report(summary))
+    with open(os.path.join(args.output_dir, 'complexity.html'), 'w') as f:
+        f.write(html_report(summary))
+
+    print(markdown_report(summary))
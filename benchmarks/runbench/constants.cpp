@@ -0,0 +1,82 @@
+// Passing a mode known at compile time to a function with 4 named parameters:
+//   RUNTIME: .mode(2), an int, which the function branches on at runtime
+//   CONSTANT: .mode(std::integral_constant<int, 2>{}) (nickel::c<2> since C++17), which selects the
+//     branch at compile time
+// Also reports the size of the builder once every argument is set.
+
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+#include "runbench.hpp"
+
+namespace {
+    NICKEL_NAME(x);
+    NICKEL_NAME(y);
+    NICKEL_NAME(z);
+    NICKEL_NAME(mode);
+
+    template <int V>
+    using int_c = std::integral_constant<int, V>;
+
+    struct kernel
+    {
+        double operator()(double x, double y, double z, int mode) const
+        {
+            switch (mode) {
+            case 0: return x + y + z;
+            case 1: return x * y * z;
+            case 2: return x * y + z;
+            default: return x / y / z;
+            }
+        }
+
+        template <int Mode>
+        double operator()(double x, double y, double z, int_c<Mode>) const
+        {
+            return (*this)(x, y, z, Mode);
+        }
+    };
+
+    auto function()
+    {
+        return nickel::wrap(x, y, z, mode)(kernel {});
+    }
+
+    // Hides the value from the optimizer, like a mode read from a configuration.
+    int opaque(int value)
+    {
+        runbench::do_not_optimize(value);
+        static int volatile sink;
+        sink = value;
+        return sink;
+    }
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 10000000;
+
+    double x_value = 1;
+    double const y_value = 2;
+    double const z_value = 3;
+
+    int const mode_value = opaque(2);
+    runbench::run("constants RUNTIME", iterations, [&] {
+        runbench::do_not_optimize(
+            function().x(x_value).y(y_value).z(z_value).mode(mode_value)());
+        x_value += 1;
+    });
+    runbench::report("constants RUNTIME", "bytes/builder",
+        static_cast<long long>(sizeof(function().x(x_value).y(y_value).z(z_value).mode(2))));
+
+    runbench::run("constants CONSTANT", iterations, [&] {
+        runbench::do_not_optimize(
+            function().x(x_value).y(y_value).z(z_value).mode(int_c<2> {})());
+        x_value += 1;
+    });
+    runbench::report("constants CONSTANT", "bytes/builder",
+        static_cast<long long>(
+            sizeof(function().x(x_value).y(y_value).z(z_value).mode(int_c<2> {}))));
+}
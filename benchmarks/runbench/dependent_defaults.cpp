@@ -0,0 +1,74 @@
+// A function whose height and area default to values computed from its width:
+//   DIRECT: no defaults; every argument is passed
+//   DEPENDENT_OVERRIDDEN: defaults computed from width, but every argument is passed
+//   DEPENDENT: defaults computed from width, of which only width is passed
+// Also reports how often the defaults are computed.
+
+#include <nickel/nickel.hpp>
+
+#include <cmath>
+#include <cstddef>
+
+#include "runbench.hpp"
+
+namespace {
+    long long computed = 0;
+
+    NICKEL_NAME(width);
+    NICKEL_NAME(height);
+    NICKEL_NAME(area);
+
+    double rectangle_impl(double width, double height, double area)
+    {
+        return width + height + area;
+    }
+
+    auto direct()
+    {
+        return nickel::wrap(width, height, area)(&rectangle_impl);
+    }
+
+    auto dependent()
+    {
+        return nickel::wrap(width,
+            height = nickel::deferred(
+                [](double width) {
+                    ++computed;
+                    return std::sqrt(width);
+                },
+                width),
+            area = nickel::deferred(
+                [](double width, double height) {
+                    ++computed;
+                    return width * height;
+                },
+                width, height))(&rectangle_impl);
+    }
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 10000000;
+    // runbench::run(...) also runs a tenth as many iterations to warm up.
+    constexpr long long runs = iterations + iterations / 10 + 1;
+
+    double x = 1;
+    runbench::run("dependent_defaults DIRECT", iterations, [&] {
+        runbench::do_not_optimize(direct().width(x).height(2.0).area(3.0)());
+        x += 1;
+    });
+
+    computed = 0;
+    runbench::run("dependent_defaults DEPENDENT_OVERRIDDEN", iterations, [&] {
+        runbench::do_not_optimize(dependent().width(x).height(2.0).area(3.0)());
+        x += 1;
+    });
+    runbench::report("dependent_defaults DEPENDENT_OVERRIDDEN", "computed/iter", computed / runs);
+
+    computed = 0;
+    runbench::run("dependent_defaults DEPENDENT", iterations, [&] {
+        runbench::do_not_optimize(dependent().width(x)());
+        x += 1;
+    });
+    runbench::report("dependent_defaults DEPENDENT", "computed/iter", computed / runs);
+}
@@ -0,0 +1,69 @@
+// Passing a large std::string and std::vector to by-value parameters:
+//   TEMPORARY: .text(std::string(...)).data(std::vector<double>(...)), moved into the parameters
+//   IN_PLACE: nickel::in_place(...), constructed directly in the parameters
+
+#include <nickel/nickel.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "runbench.hpp"
+
+namespace {
+    long long moves = 0;
+
+    // Counts the moves of a T
+    template <typename T>
+    struct counted
+    {
+        T value;
+
+        template <typename... Args>
+        explicit counted(Args&&... args)
+            : value(std::forward<Args>(args)...)
+        { }
+
+        counted(counted const&) = default;
+
+        counted(counted&& other) noexcept
+            : value(std::move(other.value))
+        {
+            ++moves;
+        }
+    };
+
+    NICKEL_NAME(text);
+    NICKEL_NAME(data);
+
+    auto function()
+    {
+        return nickel::wrap(text, data)(
+            [](counted<std::string> text, counted<std::vector<double>> data) {
+                return text.value.size() + data.value.size();
+            });
+    }
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 1000000;
+    // runbench::run(...) also runs a tenth as many iterations to warm up.
+    constexpr long long runs = iterations + iterations / 10 + 1;
+
+    moves = 0;
+    runbench::run("in_place TEMPORARY", iterations, [] {
+        runbench::do_not_optimize(function()
+                                      .text(counted<std::string>(1024, 'x'))
+                                      .data(counted<std::vector<double>>(1024, 1.0))());
+    });
+    runbench::report("in_place TEMPORARY", "moves/iter", moves / runs);
+
+    moves = 0;
+    runbench::run("in_place IN_PLACE", iterations, [] {
+        runbench::do_not_optimize(function()
+                                      .text(nickel::in_place(1024, 'x'))
+                                      .data(nickel::in_place(1024, 1.0))());
+    });
+    runbench::report("in_place IN_PLACE", "moves/iter", moves / runs);
+}
@@ -0,0 +1,145 @@
+// Materializing a call with 24 string/vector arguments:
+//   HEAP: each argument copied into its own heap allocation
+//   ARENA: nickel::materialize(...) into a stack buffer
+
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "runbench.hpp"
+
+namespace {
+    NICKEL_NAME(s0);
+    NICKEL_NAME(s1);
+    NICKEL_NAME(s2);
+    NICKEL_NAME(s3);
+    NICKEL_NAME(s4);
+    NICKEL_NAME(s5);
+    NICKEL_NAME(s6);
+    NICKEL_NAME(s7);
+    NICKEL_NAME(s8);
+    NICKEL_NAME(s9);
+    NICKEL_NAME(s10);
+    NICKEL_NAME(s11);
+    NICKEL_NAME(v0);
+    NICKEL_NAME(v1);
+    NICKEL_NAME(v2);
+    NICKEL_NAME(v3);
+    NICKEL_NAME(v4);
+    NICKEL_NAME(v5);
+    NICKEL_NAME(v6);
+    NICKEL_NAME(v7);
+    NICKEL_NAME(v8);
+    NICKEL_NAME(v9);
+    NICKEL_NAME(v10);
+    NICKEL_NAME(v11);
+
+    using str = std::string const&;
+    using vec = std::vector<int> const&;
+
+    std::size_t total_size(str s0, str s1, str s2, str s3, str s4, str s5, str s6, str s7, str s8,
+        str s9, str s10, str s11, vec v0, vec v1, vec v2, vec v3, vec v4, vec v5, vec v6, vec v7,
+        vec v8, vec v9, vec v10, vec v11)
+    {
+        return s0.size() + s1.size() + s2.size() + s3.size() + s4.size() + s5.size() + s6.size()
+            + s7.size() + s8.size() + s9.size() + s10.size() + s11.size() + v0.size() + v1.size()
+            + v2.size() + v3.size() + v4.size() + v5.size() + v6.size() + v7.size() + v8.size()
+            + v9.size() + v10.size() + v11.size();
+    }
+
+    auto function()
+    {
+        return nickel::wrap(s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, v0, v1, v2, v3, v4,
+            v5, v6, v7, v8, v9, v10, v11)([](str s0, str s1, str s2, str s3, str s4, str s5,
+                                              str s6, str s7, str s8, str s9, str s10, str s11,
+                                              vec v0, vec v1, vec v2, vec v3, vec v4, vec v5,
+                                              vec v6, vec v7, vec v8, vec v9, vec v10, vec v11) {
+            return total_size(s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, v0, v1, v2, v3, v4,
+                v5, v6, v7, v8, v9, v10, v11);
+        });
+    }
+
+    template <typename T>
+    std::unique_ptr<T> own(T const& value)
+    {
+        return std::make_unique<T>(value);
+    }
+}
+
+int main()
+{
+    std::string const s = "short";
+    std::vector<int> const v {1, 2, 3, 4};
+
+    constexpr std::size_t iterations = 200000;
+
+    runbench::run("materialize HEAP", iterations, [&] {
+        auto owned = std::make_tuple(own(s), own(s), own(s), own(s), own(s), own(s), own(s),
+            own(s), own(s), own(s), own(s), own(s), own(v), own(v), own(v), own(v), own(v),
+            own(v), own(v), own(v), own(v), own(v), own(v), own(v));
+
+        runbench::do_not_optimize(function()
+                                      .s0(*std::get<0>(owned))
+                                      .s1(*std::get<1>(owned))
+                                      .s2(*std::get<2>(owned))
+                                      .s3(*std::get<3>(owned))
+                                      .s4(*std::get<4>(owned))
+                                      .s5(*std::get<5>(owned))
+                                      .s6(*std::get<6>(owned))
+                                      .s7(*std::get<7>(owned))
+                                      .s8(*std::get<8>(owned))
+                                      .s9(*std::get<9>(owned))
+                                      .s10(*std::get<10>(owned))
+                                      .s11(*std::get<11>(owned))
+                                      .v0(*std::get<12>(owned))
+                                      .v1(*std::get<13>(owned))
+                                      .v2(*std::get<14>(owned))
+                                      .v3(*std::get<15>(owned))
+                                      .v4(*std::get<16>(owned))
+                                      .v5(*std::get<17>(owned))
+                                      .v6(*std::get<18>(owned))
+                                      .v7(*std::get<19>(owned))
+                                      .v8(*std::get<20>(owned))
+                                      .v9(*std::get<21>(owned))
+                                      .v10(*std::get<22>(owned))
+                                      .v11(*std::get<23>(owned))());
+    });
+
+    runbench::run("materialize ARENA", iterations, [&] {
+        alignas(std::max_align_t) unsigned char buffer[2048];
+        nickel::arena arena(buffer);
+
+        auto call = nickel::materialize(function()
+                                            .s0(s)
+                                            .s1(s)
+                                            .s2(s)
+                                            .s3(s)
+                                            .s4(s)
+                                            .s5(s)
+                                            .s6(s)
+                                            .s7(s)
+                                            .s8(s)
+                                            .s9(s)
+                                            .s10(s)
+                                            .s11(s)
+                                            .v0(v)
+                                            .v1(v)
+                                            .v2(v)
+                                            .v3(v)
+                                            .v4(v)
+                                            .v5(v)
+                                            .v6(v)
+                                            .v7(v)
+                                            .v8(v)
+                                            .v9(v)
+                                            .v10(v)
+                                            .v11(v),
+            arena);
+
+        runbench::do_not_optimize(std::move(call)());
+    });
+}
@@ -0,0 +1,60 @@
+// Calling an expensive pure function with 2 named parameters, at several cache hit rates:
+//   DIRECT: the nickel-wrapped function itself
+//   MEMOIZE_<rate>: nickel::memoize(...) with a 64-entry cache, where <rate>% of the calls repeat
+//   one of 16 hot arguments and the rest are new. Also reports the measured hit rate.
+
+#include <nickel/memoize.hpp>
+
+#include <cmath>
+#include <cstdio>
+
+#include "runbench.hpp"
+
+namespace {
+    NICKEL_NAME(x);
+    NICKEL_NAME(y);
+
+    double impl(int x, int y)
+    {
+        double result = 0;
+        for (int i = 1; i != 200; ++i) {
+            result += std::sqrt(static_cast<double>(x * i + y));
+        }
+        return result;
+    }
+
+    auto function()
+    {
+        return nickel::wrap(x, y = 1)(impl);
+    }
+
+    // The argument of call `i`: one of 16 hot ones `rate`% of the time, otherwise a new one.
+    int argument(std::size_t i, int rate)
+    {
+        if (static_cast<int>(i * 37 % 100) < rate) return static_cast<int>(i % 16);
+        return static_cast<int>(i) + 16;
+    }
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 1000000;
+
+    std::size_t i = 0;
+    runbench::run("memoize DIRECT", iterations, [&] {
+        runbench::do_not_optimize(function().x(argument(i++, 0))());
+    });
+
+    for (int rate : {0, 50, 90, 99}) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "memoize MEMOIZE_%d", rate);
+
+        auto memoized = nickel::memoize(function(), 64);
+        i = 0;
+        runbench::run(name, iterations, [&] {
+            runbench::do_not_optimize(memoized().x(argument(i++, rate))());
+        });
+        runbench::report(name, "% hits",
+            static_cast<long long>(100 * memoized.hits() / (memoized.hits() + memoized.misses())));
+    }
+}
@@ -0,0 +1,78 @@
+// Taking two heavy buffers out of an object with 50 members, then reading three small fields:
+//   MOVE_ALL: move the whole object, then read from the moved-to object
+//   PARTIAL_STEAL: steal the two buffers; read the small fields in place by name
+
+#include <nickel/nickel.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "runbench.hpp"
+
+// The 48 small fields
+#define SMALL_FIELDS(X)                                                                            \
+    X(f0) X(f1) X(f2) X(f3) X(f4) X(f5) X(f6) X(f7) X(f8) X(f9) X(f10) X(f11) X(f12) X(f13) X(f14)  \
+    X(f15) X(f16) X(f17) X(f18) X(f19) X(f20) X(f21) X(f22) X(f23) X(f24) X(f25) X(f26) X(f27)     \
+    X(f28) X(f29) X(f30) X(f31) X(f32) X(f33) X(f34) X(f35) X(f36) X(f37) X(f38) X(f39) X(f40)     \
+    X(f41) X(f42) X(f43) X(f44) X(f45) X(f46) X(f47)
+
+namespace {
+#define DECLARE_NAME(field) NICKEL_NAME(field);
+    SMALL_FIELDS(DECLARE_NAME)
+#undef DECLARE_NAME
+    NICKEL_NAME(payload);
+    NICKEL_NAME(attachment);
+
+    struct message
+    {
+#define DECLARE_FIELD(field) std::string field = "small";
+        SMALL_FIELDS(DECLARE_FIELD)
+#undef DECLARE_FIELD
+        std::vector<double> payload = std::vector<double>(4096, 1.0);
+        std::vector<char> attachment = std::vector<char>(4096, 'a');
+
+        auto steal() &&
+        {
+#define STEAL_FIELD(field) ::field = &message::field,
+            return nickel::steal(std::move(*this), //
+                SMALL_FIELDS(STEAL_FIELD)::payload = &message::payload,
+                ::attachment = &message::attachment);
+#undef STEAL_FIELD
+        }
+    };
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 100000;
+
+    message msg;
+    std::vector<double> payload;
+    std::vector<char> attachment;
+
+    runbench::run("partial_steal MOVE_ALL", iterations, [&] {
+        message taken = std::move(msg);
+
+        payload = std::move(taken.payload);
+        attachment = std::move(taken.attachment);
+        runbench::do_not_optimize(taken.f0.size() + taken.f17.size() + taken.f47.size());
+
+        // Put everything back for the next iteration.
+        taken.payload = std::move(payload);
+        taken.attachment = std::move(attachment);
+        msg = std::move(taken);
+    });
+
+    runbench::run("partial_steal PARTIAL_STEAL", iterations, [&] {
+        auto stolen = std::move(msg).steal().payload().attachment()();
+
+        payload = std::move(stolen.payload());
+        attachment = std::move(stolen.attachment());
+        runbench::do_not_optimize(stolen.f0().size() + stolen.f17().size() + stolen.f47().size());
+
+        // Put everything back for the next iteration.
+        msg.payload = std::move(payload);
+        msg.attachment = std::move(attachment);
+    });
+}
@@ -0,0 +1,59 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NICKEL_RUNBENCH_H_2A7C41F0
+#define NICKEL_RUNBENCH_H_2A7C41F0
+
+// A minimal harness for the runtime benchmarks.
+// Each benchmark is its own executable; results are printed one per line as
+//   <benchmark name>: <nanoseconds per iteration> ns/iter
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace runbench {
+    // Prevents the optimizer from discarding `value`.
+    template <typename T>
+    void do_not_optimize(T const& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static void const* volatile sink;
+        sink = &value;
+#endif
+    }
+
+    // Runs `fn` `iterations` times and reports the average time per iteration.
+    template <typename Fn>
+    double run(char const* name, std::size_t iterations, Fn&& fn)
+    {
+        // Warm up caches and the allocator.
+        for (std::size_t i = 0; i < iterations / 10 + 1; ++i) {
+            fn();
+        }
+
+        auto const start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            fn();
+        }
+        auto const end = std::chrono::steady_clock::now();
+
+        double const ns_per_iter
+            = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        std::printf("%s: %.2f ns/iter\n", name, ns_per_iter);
+
+        return ns_per_iter;
+    }
+
+    // Reports a counter (e.g. the number of moves) alongside the timings.
+    inline void report(char const* name, char const* counter, long long value)
+    {
+        std::printf("%s: %lld %s\n", name, value, counter);
+    }
+}
+
+#endif
@@ -0,0 +1,53 @@
+// Applying a named-parameter kernel to 1M records of 8 members, reading 2 and writing 1:
+//   AOS: calling the kernel's setters for each record in a std::vector<record>
+//   SOA: nickel::for_each_row(...) over a nickel::soa(...) table of the 3 members used
+
+#include <nickel/soa.hpp>
+
+#include <vector>
+
+#include "runbench.hpp"
+
+namespace {
+    NICKEL_NAME(x);
+    NICKEL_NAME(y);
+    NICKEL_NAME(out);
+
+    struct record
+    {
+        double x = 1;
+        double y = 2;
+        double out = 0;
+        double vx = 3;
+        double vy = 4;
+        double mass = 5;
+        long id = 6;
+        long flags = 7;
+    };
+
+    auto kernel()
+    {
+        return nickel::wrap(x, y, out)([](double x, double y, double& out) { out = x * y + out; });
+    }
+}
+
+int main()
+{
+    constexpr std::size_t records = 1000000;
+    constexpr std::size_t iterations = 50;
+
+    std::vector<record> objects(records);
+    auto table = nickel::soa(objects, ::x = &record::x, ::y = &record::y, ::out = &record::out);
+
+    runbench::run("soa AOS", iterations, [&] {
+        for (record& r : objects) {
+            kernel().x(r.x).y(r.y).out(r.out)();
+        }
+        runbench::do_not_optimize(objects);
+    });
+
+    runbench::run("soa SOA", iterations, [&] {
+        nickel::for_each_row(table, kernel());
+        runbench::do_not_optimize(table);
+    });
+}
@@ -0,0 +1,70 @@
+// Filling a 1024-entry lookup table through a function with 3 named parameters, two defaulted:
+//   STARTUP: at runtime, as a program would on startup
+//   CONSTEXPR: at compile time, as a constexpr variable; reading it costs nothing at startup
+// Also reports the size of the table.
+
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+
+#include "runbench.hpp"
+
+namespace {
+    NICKEL_NAME(x);
+    NICKEL_NAME(scale);
+    NICKEL_NAME(terms);
+
+    // A truncated series for exp(x * scale / 1024), in fixed point.
+    struct series
+    {
+        constexpr long long operator()(int x, int scale, int terms) const
+        {
+            long long const one = 1LL << 20;
+            long long const arg = one * x * scale / 1024;
+            long long term = one;
+            long long sum = one;
+            for (int n = 1; n <= terms; ++n) {
+                term = term * arg / one / n;
+                sum += term;
+            }
+            return sum;
+        }
+    };
+
+    constexpr auto exp_fixed()
+    {
+        return nickel::wrap(x, scale = 1, terms = 12)(series {});
+    }
+
+    constexpr std::size_t size = 1024;
+
+    struct table_t
+    {
+        long long values[size];
+    };
+
+    constexpr table_t make_table(int scale)
+    {
+        table_t table {};
+        for (std::size_t i = 0; i != size; ++i) {
+            table.values[i] = exp_fixed().x(static_cast<int>(i)).scale(scale)();
+        }
+        return table;
+    }
+
+    constexpr table_t table = make_table(1);
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 10000;
+
+    int scale = 1;
+    runbench::run("startup STARTUP", iterations, [&] {
+        runbench::do_not_optimize(scale);
+        runbench::do_not_optimize(make_table(scale));
+    });
+
+    runbench::run("startup CONSTEXPR", iterations, [] { runbench::do_not_optimize(&table); });
+    runbench::report("startup CONSTEXPR", "bytes", static_cast<long long>(sizeof(table)));
+}
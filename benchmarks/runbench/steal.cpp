@@ -0,0 +1,113 @@
+// Stealing large std::string / std::vector members:
+//   MAKE_TUPLE: std::tie(...) = std::make_tuple(std::move(members)...), the old steal result
+//   STEAL: nickel::steal(...), with the result bound directly
+
+#include <nickel/nickel.hpp>
+
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "runbench.hpp"
+
+namespace {
+    long long moves = 0;
+
+    // Counts the moves of a T
+    template <typename T>
+    struct counted
+    {
+        T value;
+
+        counted() = default;
+
+        explicit counted(T value)
+            : value(std::move(value))
+        { }
+
+        counted(counted const&) = default;
+        counted& operator=(counted const&) = default;
+
+        counted(counted&& other) noexcept
+            : value(std::move(other.value))
+        {
+            ++moves;
+        }
+
+        counted& operator=(counted&& other) noexcept
+        {
+            value = std::move(other.value);
+            ++moves;
+            return *this;
+        }
+    };
+
+    NICKEL_NAME(text);
+    NICKEL_NAME(data);
+    NICKEL_NAME(header);
+    NICKEL_NAME(ids);
+
+    struct message
+    {
+        counted<std::string> text;
+        counted<std::vector<double>> data;
+        counted<std::string> header;
+        counted<std::vector<int>> ids;
+
+        auto steal() &&
+        {
+            return nickel::steal(std::move(*this), //
+                ::text = &message::text, //
+                ::data = &message::data, //
+                ::header = &message::header, //
+                ::ids = &message::ids);
+        }
+    };
+
+    message make_message()
+    {
+        return message {
+            counted<std::string>(std::string(1024, 'x')),
+            counted<std::vector<double>>(std::vector<double>(1024, 1.0)),
+            counted<std::string>(std::string(256, 'y')),
+            counted<std::vector<int>>(std::vector<int>(1024, 2)),
+        };
+    }
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 100000;
+
+    moves = 0;
+    runbench::run("steal MAKE_TUPLE", iterations, [] {
+        message msg = make_message();
+        long long const before = moves;
+
+        counted<std::string> text;
+        counted<std::vector<double>> data;
+        counted<std::string> header;
+        counted<std::vector<int>> ids;
+        std::tie(text, data, header, ids) = std::make_tuple(std::move(msg.text),
+            std::move(msg.data), std::move(msg.header), std::move(msg.ids));
+
+        runbench::do_not_optimize(text.value.size() + data.value.size() + header.value.size()
+            + ids.value.size());
+        moves = moves - before;
+    });
+    runbench::report("steal MAKE_TUPLE", "moves/iter", moves);
+
+    moves = 0;
+    runbench::run("steal STEAL", iterations, [] {
+        message msg = make_message();
+        long long const before = moves;
+
+        auto stolen = std::move(msg).steal().text().data().header().ids()();
+
+        runbench::do_not_optimize(stolen.text().value.size() + stolen.data().value.size()
+            + stolen.header().value.size() + stolen.ids().value.size());
+        moves = moves - before;
+    });
+    runbench::report("steal STEAL", "moves/iter", moves);
+}
@@ -0,0 +1,56 @@
+// Calling a function with 8 named int/std::string parameters:
+//   WRAP: nickel::wrap(...)
+//   WRAP_THIN: nickel::wrap_thin(...), whose setters write to runtime slots
+
+#include <nickel/thin.hpp>
+
+#include <string>
+
+#include "runbench.hpp"
+
+namespace {
+    NICKEL_NAME(a);
+    NICKEL_NAME(b);
+    NICKEL_NAME(c);
+    NICKEL_NAME(d);
+    NICKEL_NAME(e);
+    NICKEL_NAME(f);
+    NICKEL_NAME(g);
+    NICKEL_NAME(h);
+
+    std::size_t impl(int a, int b, int c, int d, std::string const& e, std::string const& f,
+        int g, int h)
+    {
+        return a + b + c + d + e.size() + f.size() + g + h;
+    }
+
+    auto function()
+    {
+        return nickel::wrap(a, b, c, d, e, f, g = 7, h = 8)(impl);
+    }
+
+    auto thin_function()
+    {
+        return nickel::wrap_thin(a, b, c, d, e, f, g = 7, h = 8)(impl);
+    }
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 10000000;
+
+    int value = 1;
+    std::string const text = "text";
+
+    runbench::run("thin WRAP", iterations, [&] {
+        runbench::do_not_optimize(value);
+        runbench::do_not_optimize(
+            function().a(value).b(2).c(3).d(4).e(text).f(text).g(value)());
+    });
+
+    runbench::run("thin WRAP_THIN", iterations, [&] {
+        runbench::do_not_optimize(value);
+        runbench::do_not_optimize(
+            thin_function().a(value).b(2).c(3).d(4).e(text).f(text).g(value)());
+    });
+}
@@ -0,0 +1,111 @@
+// Summing 2, 4, and 8 ints passed to a multivalued name:
+//   TUPLE: ids.multivalued<N>(), a std::tuple of references, with one function per count
+//   VALUES: ids.multivalued(), a nickel::values<int>, with one function for every count
+// Also reports the heap allocations per call, and the size of the builder once the ints are set.
+
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
+#include "runbench.hpp"
+
+namespace {
+    long long allocations = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* memory = std::malloc(size)) return memory;
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace {
+    NICKEL_NAME(ids);
+
+    struct tuple_sum
+    {
+        template <typename Tuple, std::size_t... Is>
+        static int sum(Tuple const& ids, std::index_sequence<Is...>)
+        {
+            int result = 0;
+            int expand[] = {0, (result += std::get<Is>(ids))...};
+            (void)expand;
+            return result;
+        }
+
+        template <typename Tuple>
+        int operator()(Tuple const& ids) const
+        {
+            return sum(ids, std::make_index_sequence<std::tuple_size<Tuple>::value> {});
+        }
+    };
+
+    template <int N>
+    auto tuple_function()
+    {
+        return nickel::wrap(ids.multivalued<N>())(tuple_sum {});
+    }
+
+    struct values_sum
+    {
+        int operator()(nickel::values<int> ids) const
+        {
+            return std::accumulate(ids.begin(), ids.end(), 0);
+        }
+    };
+
+    auto values_function()
+    {
+        return nickel::wrap(ids.multivalued())(values_sum {});
+    }
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 10000000;
+    // runbench::run(...) also runs a tenth as many iterations to warm up.
+    constexpr long long runs = iterations + iterations / 10 + 1;
+
+    int a = 1;
+    int const b = 2;
+    int const c = 3;
+    int const d = 4;
+
+    allocations = 0;
+    runbench::run("values TUPLE", iterations, [&] {
+        runbench::do_not_optimize(tuple_function<2>().ids(a, b)());
+        runbench::do_not_optimize(tuple_function<4>().ids(a, b, c, d)());
+        runbench::do_not_optimize(tuple_function<8>().ids(a, b, c, d, a, b, c, d)());
+        a += 1;
+    });
+    runbench::report("values TUPLE", "allocations/iter", allocations / runs);
+    runbench::report("values TUPLE", "bytes/builder(8)",
+        static_cast<long long>(sizeof(tuple_function<8>().ids(a, b, c, d, a, b, c, d))));
+
+    allocations = 0;
+    runbench::run("values VALUES", iterations, [&] {
+        runbench::do_not_optimize(values_function().ids(a, b)());
+        runbench::do_not_optimize(values_function().ids(a, b, c, d)());
+        runbench::do_not_optimize(values_function().ids(a, b, c, d, a, b, c, d)());
+        a += 1;
+    });
+    runbench::report("values VALUES", "allocations/iter", allocations / runs);
+    runbench::report("values VALUES", "bytes/builder(8)",
+        static_cast<long long>(sizeof(values_function().ids(a, b, c, d, a, b, c, d))));
+}
@@ -0,0 +1,59 @@
+// Passing the members of a struct to a named-parameter function with 8 parameters:
+//   SETTERS: calling each setter with the member
+//   VIEW: passing a nickel::view(...) of the struct
+
+#include <nickel/nickel.hpp>
+
+#include <string>
+
+#include "runbench.hpp"
+
+namespace {
+    NICKEL_NAME(a);
+    NICKEL_NAME(b);
+    NICKEL_NAME(c);
+    NICKEL_NAME(d);
+    NICKEL_NAME(e);
+    NICKEL_NAME(f);
+    NICKEL_NAME(g);
+    NICKEL_NAME(h);
+
+    struct record
+    {
+        int a = 1;
+        int b = 2;
+        double c = 3;
+        double d = 4;
+        std::string e = "five";
+        std::string f = "six";
+        long g = 7;
+        long h = 8;
+    };
+
+    auto function()
+    {
+        return nickel::wrap(a, b, c, d, e, f, g, h)(
+            [](int a, int b, double c, double d, std::string const& e, std::string const& f,
+                long g, long h) { return a + b + c + d + e.size() + f.size() + g + h; });
+    }
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 10000000;
+
+    record r;
+
+    runbench::run("view SETTERS", iterations, [&] {
+        runbench::do_not_optimize(r);
+        runbench::do_not_optimize(
+            function().a(r.a).b(r.b).c(r.c).d(r.d).e(r.e).f(r.f).g(r.g).h(r.h)());
+    });
+
+    runbench::run("view VIEW", iterations, [&] {
+        runbench::do_not_optimize(r);
+        runbench::do_not_optimize(function()(nickel::view(r, //
+            ::a = &record::a, ::b = &record::b, ::c = &record::c, ::d = &record::d,
+            ::e = &record::e, ::f = &record::f, ::g = &record::g, ::h = &record::h))());
+    });
+}
@@ -1,34 +1,217 @@
+import matplotlib
+# Render to files; this must work without a display.
+matplotlib.use('Agg')
 from matplotlib import pyplot as plt
-import pickle
 
 import argparse
+import csv
+import html
+import math
+import os
+import pickle
+import re
 
-if __name__ == '__main__':
-    parser = argparse.ArgumentParser()
-    parser.add_argument('results', help='The results file to load')
 
-    args = parser.parse_args()
+def time_ms(result):
+    return (result['time'] - result['baseline']['time']) * 1e3
+
+
+def memory_mb(result):
+    return (result['memory'] - result['baseline']['memory']) / 1e3
+
+
+def stddev(values):
+    if len(values) < 2:
+        return 0.0
+    mean = sum(values) / len(values)
+    return math.sqrt(sum((v - mean) ** 2 for v in values) / (len(values) - 1))
+
+
+def time_error_ms(result):
+    # The spread of the baseline-subtracted samples, if the benchmark was measured repeatedly.
+    samples = result.get('samples')
+    if not samples:
+        return None
+    return stddev([(x['time'] - result['baseline']['time']) * 1e3 for x in samples])
+
+
+def memory_error_mb(result):
+    samples = result.get('samples')
+    if not samples:
+        return None
+    return stddev([(x['memory'] - result['baseline']['memory']) / 1e3 for x in samples])
+
+
+METRICS = [
+    ('time', 'Time (ms)', time_ms, time_error_ms),
+    ('memory', 'Memory (MB)', memory_mb, memory_error_mb),
+]
+
+
+def flatten_matrix(matrix):
+    # results[benchmark][toolchain]['whichs'][which] -> charts keyed (benchmark, which): {toolchain: results}
+    charts = dict()
+    for benchmark, bench_results in matrix.items():
+        for toolchain, toolchain_results in sorted(bench_results.items()):
+            for which, which_results in toolchain_results['whichs'].items():
+                charts.setdefault((benchmark, which), dict())[toolchain] = which_results
+    return charts
+
+
+def charts_of(results):
+    # results[benchmark][which] -> charts keyed (benchmark, None): {which: results}
+    return {(benchmark, None): dict(bench_results) for benchmark, bench_results in results.items()}
+
+
+def matrix_table(benchmark, bench_results):
+    # One row per toolchain, one column per configuration: the time at the largest N.
+    whichs = sorted({which for toolchain in bench_results.values() for which in toolchain['whichs']})
+
+    lines = [
+        f'## {benchmark}',
+        '',
+        '| Toolchain | ' + ' | '.join(f'{which} (ms)' for which in whichs) + ' |',
+        '|---' * (len(whichs) + 1) + '|',
+    ]
+    for toolchain, toolchain_results in sorted(bench_results.items()):
+        cells = []
+        for which in whichs:
+            which_results = toolchain_results['whichs'].get(which)
+            if which_results is None or not which_results['results']:
+                cells.append('-')
+                continue
+            last = which_results['results'][-1]
+            cells.append(f'{time_ms(last):.1f} (N={last["n"]})')
+        lines.append(f'| {toolchain} | ' + ' | '.join(cells) + ' |')
 
-    with open(args.results, 'rb') as f:
-        results = pickle.load(f)
+    return '\n'.join(lines)
 
-    for benchmark, bench_results in results.items():
-        plt.ylabel('Time (ms)')
-        plt.xlabel('N')
-        plt.title(benchmark)
 
-        for which, which_results in bench_results.items():
-            plt.plot([x['n'] for x in which_results['results']], [(x['time'] - x['baseline']['time']) * 1e3 for x in which_results['results']], label=which_results['which'])
+def slug(text):
+    return re.sub(r'[^A-Za-z0-9_.-]+', '_', text).strip('_')
 
-        plt.legend()
-        plt.show()
 
-        plt.ylabel('Memory (MB)')
-        plt.xlabel('N')
-        plt.title(benchmark + ' memory')
+def render_chart(output_dir, benchmark, which, curves, metric):
+    key, ylabel, value, error = metric
+    title = benchmark if which is None else f'{benchmark} {which}'
+    if key != 'time':
+        title += f' {key}'
+
+    fig, ax = plt.subplots()
+    ax.set_ylabel(ylabel)
+    ax.set_xlabel('N')
+    ax.set_title(title)
+
+    for label, curve in curves.items():
+        points = curve['results']
+        ns = [x['n'] for x in points]
+        ys = [value(x) for x in points]
+        errors = [error(x) for x in points]
+        if any(e is not None for e in errors):
+            ax.errorbar(ns, ys, yerr=[e or 0.0 for e in errors], label=label, capsize=3)
+        else:
+            ax.plot(ns, ys, label=label)
+
+    ax.legend()
+
+    name = slug(title)
+    for extension in ('png', 'svg'):
+        fig.savefig(os.path.join(output_dir, f'{name}.{extension}'))
+    plt.close(fig)
+
+    return title, name
+
+
+def write_csv(path, charts):
+    with open(path, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['benchmark', 'toolchain', 'which', 'n', 'm', 'time_ms', 'time_stddev_ms',
+            'memory_mb', 'memory_stddev_mb', 'raw_time_s', 'raw_memory_kb',
+            'baseline_time_s', 'baseline_memory_kb'])
+
+        for (benchmark, which), curves in sorted(charts.items(), key=lambda c: (c[0][0], c[0][1] or '')):
+            for label, curve in curves.items():
+                # Matrix charts are labelled by toolchain; regular charts by which.
+                toolchain, row_which = (label, which) if which is not None else ('', label)
+                for x in curve['results']:
+                    time_error = time_error_ms(x)
+                    memory_error = memory_error_mb(x)
+                    writer.writerow([benchmark, toolchain, row_which, x['n'], x['m'],
+                        f'{time_ms(x):.6g}', '' if time_error is None else f'{time_error:.6g}',
+                        f'{memory_mb(x):.6g}', '' if memory_error is None else f'{memory_error:.6g}',
+                        x['time'], x['memory'], x['baseline']['time'], x['baseline']['memory']])
+
+
+def write_dashboard(path, sections):
+    body = []
+    for benchmark, images in sections:
+        body.append(f'<h2>{html.escape(benchmark)}</h2>')
+        body.append('<div class="charts">')
+        for title, name in images:
+            body.append(f'<figure><a href="{name}.png"><img src="{name}.svg" alt="{html.escape(title)}"></a>'
+                f'<figcaption>{html.escape(title)}</figcaption></figure>')
+        body.append('</div>')
+
+    with open(path, 'w') as f:
+        f.write(f'''<!DOCTYPE html>
+<html>
+<head>
+<meta charset="utf-8">
+<title>Buildbench results</title>
+<style>
+.charts {{ display: flex; flex-wrap: wrap; }}
+figure {{ margin: 0.5em; }}
+img {{ width: 480px; }}
+</style>
+</head>
+<body>
+<h1>Buildbench results</h1>
+<p>Compile time and memory against N, with the baseline subtracted.
+Error bars show the standard deviation when each N was measured several times.
+<a href="results.csv">Download as CSV</a>.</p>
+{chr(10).join(body)}
+</body>
+</html>
+''')
+
+
+def render(output_dir, charts):
+    os.makedirs(output_dir, exist_ok=True)
+
+    sections = dict()
+    for (benchmark, which), curves in sorted(charts.items(), key=lambda c: (c[0][0], c[0][1] or '')):
+        for metric in METRICS:
+            sections.setdefault(benchmark, []).append(render_chart(output_dir, benchmark, which, curves, metric))
+
+    write_csv(os.path.join(output_dir, 'results.csv'), charts)
+    write_dashboard(os.path.join(output_dir, 'index.html'), sorted(sections.items()))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('results', nargs='?', help='The results file to load')
+    parser.add_argument('--matrix', help='A compiler matrix results file (from `bench.py matrix`) to load')
+    parser.add_argument('-o', '--output-dir', required=True,
+        help='Where to write the charts (PNG and SVG), index.html, and results.csv')
+
+    args = parser.parse_args()
+    if args.results is None and args.matrix is None:
+        parser.error('expected a results file or --matrix')
 
-        for which, which_results in bench_results.items():
-            plt.plot([x['n'] for x in which_results['results']], [(x['memory'] - x['baseline']['memory']) / 1e3 for x in which_results['results']], label=which_results['which'])
+    charts = dict()
+    if args.results is not None:
+        with open(args.results, 'rb') as f:
+            charts.update(charts_of(pickle.load(f)))
+    tables = []
+    if args.matrix is not None:
+        with open(args.matrix, 'rb') as f:
+            matrix = pickle.load(f)
+        charts.update(flatten_matrix(matrix))
+        tables = [matrix_table(benchmark, bench_results) for benchmark, bench_results in sorted(matrix.items())]
 
-        plt.legend()
-        plt.show()
+    render(args.output_dir, charts)
+    if tables:
+        with open(os.path.join(args.output_dir, 'matrix.md'), 'w') as f:
+            f.write('\n\n'.join(tables) + '\n')
+        print('\n\n'.join(tables))
+    print(f'Wrote {os.path.join(args.output_dir, "index.html")}')
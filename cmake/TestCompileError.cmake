@@ -1,10 +1,50 @@
+# Run as a script (`cmake -P`) by each test: builds TARGET, which must fail, and checks that the
+# failure was quick and concise if MAX_SECONDS or MAX_DIAGNOSTIC_LINES are given.
+if(CMAKE_SCRIPT_MODE_FILE)
+  string(TIMESTAMP start "%s" UTC)
+  set(config)
+  if(CONFIG)
+    set(config --config ${CONFIG})
+  endif()
+
+  execute_process(
+    COMMAND ${CMAKE_COMMAND} --build ${BINARY_DIR} ${config} --target ${TARGET}
+    RESULT_VARIABLE result
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE output
+  )
+  string(TIMESTAMP end "%s" UTC)
+
+  if(result EQUAL 0)
+    message(FATAL_ERROR "Compilation succeeded, but it was expected to fail")
+  endif()
+
+  # The output includes the build tool's own lines, so leave some room for those.
+  string(REGEX MATCHALL "\n" newlines "${output}")
+  list(LENGTH newlines lines)
+  if(DEFINED MAX_DIAGNOSTIC_LINES AND lines GREATER MAX_DIAGNOSTIC_LINES)
+    message(FATAL_ERROR
+      "The diagnostic is ${lines} lines long, more than ${MAX_DIAGNOSTIC_LINES}:\n${output}")
+  endif()
+
+  math(EXPR seconds "${end} - ${start}")
+  if(DEFINED MAX_SECONDS AND seconds GREATER MAX_SECONDS)
+    message(FATAL_ERROR "Compilation took ${seconds}s to fail, more than ${MAX_SECONDS}s")
+  endif()
+
+  message(STATUS "Compilation failed as expected (${lines} lines, ${seconds}s)")
+  return()
+endif()
+
+set(_TEST_COMPILE_ERROR_SCRIPT ${CMAKE_CURRENT_LIST_FILE})
+
 function(add_compile_failure_test file)
   get_filename_component(abspath ${file} ABSOLUTE)
   file(RELATIVE_PATH target_name ${CMAKE_SOURCE_DIR} ${abspath})
   string(MAKE_C_IDENTIFIER ${target_name} target_name)
   set(target_name compilefailure.test.${target_name})
 
-  cmake_parse_arguments(PARSE_ARGV 1 ARG "" "" "LINK_LIBRARIES")
+  cmake_parse_arguments(PARSE_ARGV 1 ARG "" "MAX_DIAGNOSTIC_LINES;MAX_SECONDS" "LINK_LIBRARIES")
 
   if(ARG_UNPARSED_ARGUMENTS)
     message(FATAL_ERROR "Unknown arguments ${ARG_UNPARSED_ARGUMENTS}")
@@ -16,27 +56,46 @@ function(add_compile_failure_test file)
   set_property(TARGET ${target_name} PROPERTY EXCLUDE_FROM_DEFAULT_BUILD TRUE)
   set_property(SOURCE ${file} PROPERTY COMPILE_FAILURE_TEST_TARGET ${target_name})
 
+  # An empty --config is an error, so pass it only in multi-config builds.
+  set(config "$<$<BOOL:$<CONFIG>>:--config>" "$<CONFIG>")
+
   add_custom_target(testrunner.${target_name}
     DEPENDS ${file}
-    COMMAND ${CMAKE_COMMAND} --build ${CMAKE_BINARY_DIR} --config $<CONFIG> --target ${target_name}
+    COMMAND ${CMAKE_COMMAND} --build ${CMAKE_BINARY_DIR} ${config} --target ${target_name}
     COMMAND ${CMAKE_COMMAND} -E remove -f $<TARGET_OBJECTS:${target_name}>
   )
+
+  set(bounds)
+  if(DEFINED ARG_MAX_DIAGNOSTIC_LINES)
+    list(APPEND bounds -DMAX_DIAGNOSTIC_LINES=${ARG_MAX_DIAGNOSTIC_LINES})
+  endif()
+  if(DEFINED ARG_MAX_SECONDS)
+    list(APPEND bounds -DMAX_SECONDS=${ARG_MAX_SECONDS})
+  endif()
+
   add_test(
     NAME test.${target_name}
-    COMMAND ${CMAKE_COMMAND} --build ${CMAKE_BINARY_DIR} --config $<CONFIG> --target testrunner.${target_name}
-  )
-  set_tests_properties(test.${target_name}
-    PROPERTIES
-      WILL_FAIL TRUE
+    COMMAND ${CMAKE_COMMAND}
+      -DBINARY_DIR=${CMAKE_BINARY_DIR}
+      "-DCONFIG=$<CONFIG>"
+      -DTARGET=testrunner.${target_name}
+      ${bounds}
+      -P ${_TEST_COMPILE_ERROR_SCRIPT}
   )
 endfunction()
 
+# add_compile_failure_tests(files... LINK_LIBRARIES libs... [MAX_DIAGNOSTIC_LINES n] [MAX_SECONDS s])
 function(add_compile_failure_tests)
-  list(FIND ARGV LINK_LIBRARIES link_libraries_index)
-  list(SUBLIST ARGV 0 ${link_libraries_index} files)
-  list(SUBLIST ARGV ${link_libraries_index} -1 link_libraries)
+  cmake_parse_arguments(PARSE_ARGV 0 ARG "" "MAX_DIAGNOSTIC_LINES;MAX_SECONDS" "LINK_LIBRARIES")
+
+  set(bounds)
+  foreach(bound IN ITEMS MAX_DIAGNOSTIC_LINES MAX_SECONDS)
+    if(DEFINED ARG_${bound})
+      list(APPEND bounds ${bound} ${ARG_${bound}})
+    endif()
+  endforeach()
 
-  foreach(file IN LISTS files)
-    add_compile_failure_test(${file} ${link_libraries})
+  foreach(file IN LISTS ARG_UNPARSED_ARGUMENTS)
+    add_compile_failure_test(${file} LINK_LIBRARIES ${ARG_LINK_LIBRARIES} ${bounds})
   endforeach()
 endfunction()
@@ -0,0 +1,298 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NICKEL_MEMOIZE_H_8E3D5A17
+#define NICKEL_MEMOIZE_H_8E3D5A17
+
+// nickel::memoize(...) lives in its own header, as the cache needs <list> and <unordered_map>,
+// which most users of nickel.hpp shouldn't have to compile.
+
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+#include <functional> // std::hash
+#include <list>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace nickel {
+    namespace detail {
+        // The mutex of an unsynchronized nickel::memoize(...).
+        struct null_mutex
+        {
+            void lock() noexcept
+            { }
+
+            void unlock() noexcept
+            { }
+        };
+
+        template <typename Mutex>
+        class memo_lock
+        {
+        public:
+            explicit memo_lock(Mutex& mutex)
+                : mutex_ {mutex}
+            {
+                mutex_.lock();
+            }
+
+            memo_lock(memo_lock const&) = delete;
+            memo_lock& operator=(memo_lock const&) = delete;
+
+            ~memo_lock()
+            {
+                mutex_.unlock();
+            }
+
+        private:
+            Mutex& mutex_;
+        };
+
+        // Hashes a memo key: the function's arguments, one per parameter in order.
+        struct memo_hash
+        {
+            template <typename... Ts>
+            std::size_t operator()(std::tuple<Ts...> const& key) const
+            {
+                return hash(key, std::index_sequence_for<Ts...> {});
+            }
+
+        private:
+            template <typename... Ts, std::size_t... Is>
+            static std::size_t hash(std::tuple<Ts...> const& key, std::index_sequence<Is...>)
+            {
+                std::size_t seed = 0;
+                int expand[] = {0,
+                    (seed ^= std::hash<Ts> {}(std::get<Is>(key)) + 0x9e3779b9 + (seed << 6)
+                         + (seed >> 2),
+                        0)...};
+                (void)expand;
+                return seed;
+            }
+        };
+
+        // A bounded least-recently-used cache from the arguments to the result.
+        template <typename Key, typename Result, typename Mutex>
+        class memo_cache
+        {
+        public:
+            explicit memo_cache(std::size_t capacity)
+                : capacity_ {capacity}
+            { }
+
+            template <typename Fn, typename... Args>
+            Result get(Fn& fn, Args&&... args)
+            {
+                Key key {args...};
+                {
+                    memo_lock<Mutex> lock {mutex_};
+                    auto found = index_.find(key);
+                    if (found != index_.end()) {
+                        ++hits_;
+                        entries_.splice(entries_.begin(), entries_, found->second);
+                        return found->second->second;
+                    }
+                    ++misses_;
+                }
+
+                // Not under the lock, so that other arguments can be looked up meanwhile.
+                Result result = fn(NICKEL_DETAIL_FWD(args)...);
+
+                memo_lock<Mutex> lock {mutex_};
+                if (index_.find(key) == index_.end()) {
+                    entries_.emplace_front(key, result);
+                    index_.emplace(NICKEL_DETAIL_MOVE(key), entries_.begin());
+                    if (entries_.size() > capacity_) {
+                        index_.erase(entries_.back().first);
+                        entries_.pop_back();
+                    }
+                }
+                return result;
+            }
+
+            std::size_t hits() const
+            {
+                memo_lock<Mutex> lock {mutex_};
+                return hits_;
+            }
+
+            std::size_t misses() const
+            {
+                memo_lock<Mutex> lock {mutex_};
+                return misses_;
+            }
+
+            std::size_t size() const
+            {
+                memo_lock<Mutex> lock {mutex_};
+                return entries_.size();
+            }
+
+            void clear()
+            {
+                memo_lock<Mutex> lock {mutex_};
+                index_.clear();
+                entries_.clear();
+            }
+
+        private:
+            using entries_t = std::list<std::pair<Key, Result>>;
+
+            std::size_t capacity_;
+            std::size_t hits_ = 0;
+            std::size_t misses_ = 0;
+            // Most recently used first.
+            entries_t entries_;
+            std::unordered_map<Key, typename entries_t::iterator, memo_hash> index_;
+            mutable Mutex mutex_;
+        };
+
+        // Takes the place of the wrapped function, looking up the arguments in the cache first.
+        // The arguments arrive with every default applied, in the order of the function's names.
+        template <typename Fn, typename Cache, typename Params = typename fn_signature<Fn>::params>
+        struct memo_fn;
+
+        template <typename Fn, typename Cache, typename... Params>
+        struct memo_fn<Fn, Cache, type_list<Params...>>
+        {
+            Fn fn;
+            Cache* cache;
+
+            // Each argument is converted to its parameter once, for both the key and the call, so
+            // that e.g. a nickel::in_place(...) argument is only constructed once.
+            template <typename... Args>
+            decltype(auto) operator()(Args&&... args)
+            {
+                return cache->get(fn, static_cast<Params>(NICKEL_DETAIL_FWD(args))...);
+            }
+        };
+
+        template <typename WrappedFn>
+        struct memo_traits
+        {
+            static constexpr bool is_wrapped_fn = false;
+        };
+
+        template <typename Defaults, typename Fn, typename Kwargs, typename Names,
+            typename CallEvalPolicy>
+        struct memo_traits<wrapped_fn<Defaults, storage<>, Fn, Kwargs, Names, CallEvalPolicy>>
+        {
+            static constexpr bool is_wrapped_fn = true;
+            static constexpr bool has_kwargs
+                = Kwargs::count != 0 || Names::template contains<rest_name>;
+            using fn = Fn;
+        };
+
+        template <typename Fn, typename Params = typename fn_signature<Fn>::params>
+        struct memo_types;
+
+        template <typename Fn, typename... Params>
+        struct memo_types<Fn, type_list<Params...>>
+        {
+            // The cache key has one element per parameter, so its layout follows the names.
+            using key = std::tuple<std::decay_t<Params>...>;
+            using result = std::decay_t<decltype(std::declval<Fn&>()(std::declval<Params>()...))>;
+        };
+
+        // The result of nickel::memoize(...): call it to start a call of the memoized function.
+        template <typename WrappedFn, typename Mutex>
+        class memoized
+        {
+        private:
+            using fn_t = typename memo_traits<WrappedFn>::fn;
+            using cache_t = memo_cache<typename memo_types<fn_t>::key,
+                typename memo_types<fn_t>::result, Mutex>;
+
+            WrappedFn fn_;
+            std::unique_ptr<cache_t> cache_;
+
+        public:
+            explicit memoized(WrappedFn&& fn, std::size_t capacity)
+                : fn_ {NICKEL_DETAIL_MOVE(fn)}
+                , cache_ {new cache_t(capacity)}
+            { }
+
+            // A fresh call of the function, which shares this cache. It must not outlive *this.
+            auto operator()() const
+            {
+                cache_t* cache = cache_.get();
+                return WrappedFn {fn_}._map_fn(priv_tag {}, [cache](fn_t&& fn) {
+                    return memo_fn<fn_t, cache_t> {NICKEL_DETAIL_MOVE(fn), cache};
+                });
+            }
+
+            // How many calls were answered from the cache.
+            std::size_t hits() const
+            {
+                return cache_->hits();
+            }
+
+            // How many calls had to call the function.
+            std::size_t misses() const
+            {
+                return cache_->misses();
+            }
+
+            // How many results are cached.
+            std::size_t size() const
+            {
+                return cache_->size();
+            }
+
+            void clear()
+            {
+                cache_->clear();
+            }
+        };
+
+        template <typename Mutex, typename WrappedFn>
+        auto make_memoized(std::true_type, WrappedFn&& fn, std::size_t capacity)
+        {
+            return memoized<remove_cvref_t<WrappedFn>, Mutex> {
+                remove_cvref_t<WrappedFn>(NICKEL_DETAIL_FWD(fn)),
+                capacity,
+            };
+        }
+
+        // The function returns void; already reported by a static_assert in nickel::memoize(...).
+        template <typename Mutex, typename WrappedFn>
+        invalid_call make_memoized(std::false_type, WrappedFn&&, std::size_t)
+        {
+            return {};
+        }
+    }
+
+    // Caches the results of a pure function, keyed on its arguments after defaults are applied.
+    // Keeps at most `capacity` results, evicting the least recently used. Pass a `Mutex` (e.g.
+    // `nickel::memoize<std::mutex>(...)`) to share the cache between threads.
+    //   auto area = nickel::memoize(rectangle(), 1024);
+    //   area().width(2).height(3)();
+    // `fn` must come from `nickel::wrap(...)(...)`, with no arguments set yet, and have a single,
+    // non-template signature whose parameters can be hashed with std::hash, and return a value.
+    template <typename Mutex = detail::null_mutex, typename WrappedFn>
+    auto memoize(WrappedFn&& fn, std::size_t capacity)
+    {
+        using traits = detail::memo_traits<detail::remove_cvref_t<WrappedFn>>;
+        static_assert(traits::is_wrapped_fn,
+            "nickel::memoize(...) takes a function made with nickel::wrap(...)(...), with no "
+            "arguments set yet");
+        static_assert(detail::fn_signature<typename traits::fn>::fixed,
+            "nickel::memoize(...) requires a function with a single, non-template signature");
+        static_assert(!traits::has_kwargs, "nickel::memoize(...) does not support kwargs");
+        using result = typename detail::memo_types<typename traits::fn>::result;
+        static_assert(!std::is_void<result>::value,
+            "nickel::memoize(...) requires a function which returns a value");
+
+        return detail::make_memoized<Mutex>(
+            std::integral_constant<bool, !std::is_void<result>::value> {},
+            NICKEL_DETAIL_FWD(fn), capacity);
+    }
+}
+
+#endif
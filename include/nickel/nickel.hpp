@@ -11,10 +11,29 @@
 // rather than working _with_ nickel. Even so, after the close of the `detail` namespace, you can
 // find documentation on using Nickel.
 
-#include <memory> // std::addressof
+#include <cstddef>
+#include <memory> // std::addressof, std::align
+#include <new>
 #include <tuple>
 #include <type_traits>
 
+// Forces inlining of the one-line forwarding functions of the builder chain, even at -O0. Each
+// one would otherwise be emitted out of line with a mangled name spelling out every bound type,
+// which grows as O(N^2) in the number of names; inlined, they leave neither code nor a symbol.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define NICKEL_DETAIL_INLINE __forceinline
+#else
+#define NICKEL_DETAIL_INLINE inline __attribute__((always_inline))
+#endif
+
+// `constexpr` for the functions which construct values into a union, which constant expressions
+// only allow since C++20.
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc)
+#define NICKEL_DETAIL_CONSTEXPR20 constexpr
+#else
+#define NICKEL_DETAIL_CONSTEXPR20
+#endif
+
 // std::forward
 #define NICKEL_DETAIL_FWD(...) static_cast<decltype(__VA_ARGS__)&&>(__VA_ARGS__)
 // std::move
@@ -82,29 +101,17 @@ namespace nickel {
             static constexpr int value = N;
         };
 
-        // Used to implement mp_map_find, simply inherits from all the types.
+        // Used to implement names_t::contains, simply inherits from all the types.
         template <typename... Ts>
         struct inherit : Ts...
         { };
 
-        // Slightly modified version of `mp_map_find` from Boost.MP11, copied
-        // with permission from Peter Dimov.
-        template <typename K, typename... Ts>
-        struct mp_map_find_impl
+        // std::addressof, which is only constexpr since C++17.
+        template <typename T>
+        constexpr T* addressof(T& value) noexcept
         {
-            using U = inherit<tag_t<Ts>...>;
-
-            // L<K, U...> matches any template something<K, anything...>.
-            // This L<K, U...> element would be one of the types in Ts....
-            template <template <typename...> class L, typename... U>
-            static tag_t<L<K, U...>> f(tag_t<L<K, U...>>*);
-            static tag_t<void> f(...);
-
-            // The `U*` can be converted to `tag_t` of any of the Ts...
-            using V = decltype(f((U*)nullptr));
-
-            using type = typename V::type;
-        };
+            return __builtin_addressof(value);
+        }
 
         // A function taking a priv_tag is effectively private.
         // We use this because several Nickel types can have arbitrary member functions (from the
@@ -120,10 +127,393 @@ namespace nickel {
         template <typename Name, typename T>
         struct named
         {
+            using name_type = Name;
+            using value_type = T;
+
             // The bound value. May be a reference (in fact, often is a reference).
             T value;
         };
 
+        // A bound std::integral_constant (e.g. nickel::c<V>). Its value is part of the type, so
+        // it is not stored: the named<...> is empty, and costs the storage<...> nothing.
+        template <typename Name, typename T, typename Constant>
+        struct constant_named
+        {
+            using name_type = Name;
+            using value_type = T;
+
+            // Not const, so that it binds to the T&& which the named<...> would otherwise hold.
+            static Constant value;
+
+            constexpr constant_named() = default;
+
+            constexpr explicit constant_named(Constant)
+            { }
+        };
+
+        template <typename Name, typename T, typename Constant>
+        Constant constant_named<Name, T, Constant>::value;
+
+        template <typename Name, typename T, T V>
+        struct named<Name, std::integral_constant<T, V>>
+            : constant_named<Name, std::integral_constant<T, V>, std::integral_constant<T, V>>
+        {
+            using constant_named<Name, std::integral_constant<T, V>,
+                std::integral_constant<T, V>>::constant_named;
+        };
+
+        template <typename Name, typename T, T V>
+        struct named<Name, std::integral_constant<T, V>&&>
+            : constant_named<Name, std::integral_constant<T, V>&&, std::integral_constant<T, V>>
+        {
+            using constant_named<Name, std::integral_constant<T, V>&&,
+                std::integral_constant<T, V>>::constant_named;
+        };
+
+        template <typename Name, typename T, T V>
+        struct named<Name, std::integral_constant<T, V>&>
+            : constant_named<Name, std::integral_constant<T, V>&, std::integral_constant<T, V>>
+        {
+            using constant_named<Name, std::integral_constant<T, V>&,
+                std::integral_constant<T, V>>::constant_named;
+        };
+
+        template <typename Name, typename T, T V>
+        struct named<Name, std::integral_constant<T, V> const&>
+            : constant_named<Name, std::integral_constant<T, V> const&,
+                  std::integral_constant<T, V>>
+        {
+            using constant_named<Name, std::integral_constant<T, V> const&,
+                std::integral_constant<T, V>>::constant_named;
+        };
+
+        // Finds the named<Name, T> base of a storage<...>, given a pointer to the storage; void if
+        // Name is not bound. Only the pointer conversion depends on all of the bound names, so
+        // looking up each of N names doesn't instantiate N templates over the whole list.
+        // Must be used where the storage's (private) bases are accessible.
+        template <typename Name, typename T>
+        named<Name, T> base_named(named<Name, T>*);
+
+        template <typename Name>
+        void base_named(...);
+
+        // The arguments of a `.multivalued()` name (see nickel::values): a random-access range of
+        // references to them. The same type for any number of arguments.
+        template <typename T>
+        class values
+        {
+        public:
+            class iterator
+            {
+            public:
+                using iterator_category = std::random_access_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = T const*;
+                using reference = T const&;
+
+                constexpr iterator() noexcept = default;
+
+                constexpr explicit iterator(T const* const* ref) noexcept
+                    : ref_ {ref}
+                { }
+
+                constexpr T const& operator*() const noexcept
+                {
+                    return **ref_;
+                }
+
+                constexpr T const* operator->() const noexcept
+                {
+                    return *ref_;
+                }
+
+                constexpr T const& operator[](std::ptrdiff_t offset) const noexcept
+                {
+                    return *ref_[offset];
+                }
+
+                constexpr iterator& operator++() noexcept
+                {
+                    ++ref_;
+                    return *this;
+                }
+
+                constexpr iterator operator++(int) noexcept
+                {
+                    iterator old = *this;
+                    ++ref_;
+                    return old;
+                }
+
+                constexpr iterator& operator--() noexcept
+                {
+                    --ref_;
+                    return *this;
+                }
+
+                constexpr iterator operator--(int) noexcept
+                {
+                    iterator old = *this;
+                    --ref_;
+                    return old;
+                }
+
+                constexpr iterator& operator+=(std::ptrdiff_t offset) noexcept
+                {
+                    ref_ += offset;
+                    return *this;
+                }
+
+                constexpr iterator& operator-=(std::ptrdiff_t offset) noexcept
+                {
+                    ref_ -= offset;
+                    return *this;
+                }
+
+                friend constexpr iterator operator+(iterator it, std::ptrdiff_t offset) noexcept
+                {
+                    return it += offset;
+                }
+
+                friend constexpr iterator operator+(std::ptrdiff_t offset, iterator it) noexcept
+                {
+                    return it += offset;
+                }
+
+                friend constexpr iterator operator-(iterator it, std::ptrdiff_t offset) noexcept
+                {
+                    return it -= offset;
+                }
+
+                friend constexpr std::ptrdiff_t operator-(iterator lhs, iterator rhs) noexcept
+                {
+                    return lhs.ref_ - rhs.ref_;
+                }
+
+                friend constexpr bool operator==(iterator lhs, iterator rhs) noexcept
+                {
+                    return lhs.ref_ == rhs.ref_;
+                }
+
+                friend constexpr bool operator!=(iterator lhs, iterator rhs) noexcept
+                {
+                    return lhs.ref_ != rhs.ref_;
+                }
+
+                friend constexpr bool operator<(iterator lhs, iterator rhs) noexcept
+                {
+                    return lhs.ref_ < rhs.ref_;
+                }
+
+                friend constexpr bool operator>(iterator lhs, iterator rhs) noexcept
+                {
+                    return lhs.ref_ > rhs.ref_;
+                }
+
+                friend constexpr bool operator<=(iterator lhs, iterator rhs) noexcept
+                {
+                    return lhs.ref_ <= rhs.ref_;
+                }
+
+                friend constexpr bool operator>=(iterator lhs, iterator rhs) noexcept
+                {
+                    return lhs.ref_ >= rhs.ref_;
+                }
+
+            private:
+                T const* const* ref_ = nullptr;
+            };
+
+            using value_type = T;
+            using size_type = std::size_t;
+            using const_iterator = iterator;
+
+            // No values.
+            constexpr values() noexcept = default;
+
+            // NOT PUBLIC API
+            constexpr explicit values(priv_tag, T const* const* refs, std::size_t size) noexcept
+                : refs_ {refs}
+                , size_ {size}
+            { }
+
+            constexpr std::size_t size() const noexcept
+            {
+                return size_;
+            }
+
+            constexpr bool empty() const noexcept
+            {
+                return size_ == 0;
+            }
+
+            constexpr T const& operator[](std::size_t index) const noexcept
+            {
+                return *refs_[index];
+            }
+
+            constexpr iterator begin() const noexcept
+            {
+                return iterator(refs_);
+            }
+
+            constexpr iterator end() const noexcept
+            {
+                return iterator(refs_ + size_);
+            }
+
+        private:
+            T const* const* refs_ = nullptr;
+            std::size_t size_ = 0;
+        };
+
+        // The bound value of a `.multivalued()` name: the addresses of its K arguments, which
+        // outlive the call. The function receives them as a values<T>.
+        template <typename T, std::size_t K>
+        struct value_refs
+        {
+            T const* refs[K];
+
+            constexpr values<T> view() const noexcept
+            {
+                return values<T>(priv_tag {}, refs, K);
+            }
+        };
+
+        // A copy of the arguments of a value_refs<T, K>, made by nickel::materialize(...). It
+        // refers to itself, so it is constructed in place and never moved.
+        template <typename T, std::size_t K>
+        class owned_values
+        {
+        public:
+            explicit owned_values(value_refs<T, K> const& source)
+                : owned_values(source, std::make_index_sequence<K> {})
+            { }
+
+            owned_values(owned_values const&) = delete;
+            owned_values& operator=(owned_values const&) = delete;
+
+            values<T> view() const noexcept
+            {
+                return values<T>(priv_tag {}, refs_, K);
+            }
+
+        private:
+            template <std::size_t... Is>
+            owned_values(value_refs<T, K> const& source, std::index_sequence<Is...>)
+                : values_ {*source.refs[Is]...}
+                , refs_ {(values_ + Is)...}
+            { }
+
+            T values_[K];
+            T const* refs_[K];
+        };
+
+        // The type which owns a copy of a bound value of type `T`.
+        template <typename T>
+        struct owning
+        {
+            using type = remove_cvref_t<T>;
+        };
+
+        // Multivalued arguments are tuples of references; own the elements instead.
+        template <typename... Ts>
+        struct owning<std::tuple<Ts...>>
+        {
+            using type = std::tuple<remove_cvref_t<Ts>...>;
+        };
+
+        template <typename T, std::size_t K>
+        struct owning<value_refs<T, K>>
+        {
+            using type = owned_values<T, K>;
+        };
+
+        template <typename T>
+        using owning_t = typename owning<remove_cvref_t<T>>::type;
+
+        template <typename... Args>
+        class in_place_args;
+
+        // Constructs the copy of `value` in an arena; see owning_param.
+        template <typename T, typename U>
+        T* construct_owned(void* buffer, U&& value)
+        {
+            return ::new (buffer) T(NICKEL_FWD(value));
+        }
+
+        // Calls the conversion directly: as a constructor argument, it would be ambiguous with any
+        // other constructor which the in_place_args could also convert to an argument for.
+        template <typename T, typename... Args>
+        T* construct_owned(void* buffer, in_place_args<Args...>&& args)
+        {
+            return ::new (buffer) T(NICKEL_MOVE(args).operator T());
+        }
+
+        // Copies values into an arena, destroying the copies again if a later copy throws.
+        template <std::size_t N>
+        class arena_rollback
+        {
+        public:
+            arena_rollback() = default;
+            arena_rollback(arena_rollback const&) = delete;
+            arena_rollback& operator=(arena_rollback const&) = delete;
+
+            ~arena_rollback()
+            {
+                while (count_ != 0) {
+                    --count_;
+                    destroy_[count_](objects_[count_]);
+                }
+            }
+
+            template <typename T, typename Arena, typename U>
+            T& emplace(Arena& arena, U&& value)
+            {
+                T* const result = detail::construct_owned<T>(
+                    arena.allocate(sizeof(T), alignof(T)), NICKEL_FWD(value));
+                objects_[count_] = result;
+                destroy_[count_] = [](void* object) { static_cast<T*>(object)->~T(); };
+                ++count_;
+
+                return *result;
+            }
+
+            // Keeps the copies alive; they are now owned by someone else.
+            void release() noexcept
+            {
+                count_ = 0;
+            }
+
+        private:
+            // +1 to avoid zero-sized arrays.
+            void* objects_[N + 1];
+            void (*destroy_[N + 1])(void*);
+            std::size_t count_ = 0;
+        };
+
+        template <typename T>
+        void destroy_value(T& value) noexcept
+        {
+            value.~T();
+        }
+
+        // The value of a constant_named is shared, so it must not be destroyed. There is nothing to
+        // destroy, anyway.
+        template <typename T, T V>
+        void destroy_value(std::integral_constant<T, V>&) noexcept
+        { }
+
+        // Whether any default argument in the storage<...> `Defaults` depends on the arguments for
+        // other names (see nickel::deferred(fn, names...)).
+        template <typename Defaults>
+        struct has_dependencies;
+
+        // Calls a function with defaults which depend on other arguments (see names_t::map_reduce).
+        template <typename Storage, typename Defaults, typename Names>
+        struct dependent_call;
+
         // A metaprogramming list of names.
         template <typename... Names>
         struct names_t
@@ -139,8 +529,30 @@ namespace nickel {
             template <typename Rhs>
             using append_names = typename Rhs::template apply<append>;
 
+            // Is `Name` one of the Names?
+            template <typename Name>
+            static constexpr bool contains
+                = std::is_base_of<tag_t<Name>, inherit<tag_t<Names>...>>::value;
+
+            // The Name at position I.
+            template <std::size_t I>
+            using at = std::tuple_element_t<I, std::tuple<Names...>>;
+
+            // The position of `Name` in the Names, or `count` if it is not present.
+            template <typename Name>
+            static constexpr std::size_t index_of()
+            {
+                constexpr bool matches[] = {NICKEL_IS_SAME(Name, Names)..., true};
+
+                std::size_t index = 0;
+                while (!matches[index]) ++index;
+
+                return index;
+            }
+
             // TODO: figure out what this is and where it belongs.
-            template <typename Fn, typename Storage, typename Defaults, typename... Extra>
+            template <typename Fn, typename Storage, typename Defaults, typename... Extra,
+                std::enable_if_t<!has_dependencies<remove_cvref_t<Defaults>>::value, int> = 0>
             static constexpr auto map_reduce(Fn&& reduce, Storage&& storage, Defaults&& defaults,
                 Extra&&... extra) -> decltype(reduce(NICKEL_FWD(extra)...,
                 NICKEL_FWD(storage).get_or_default(tag_t<Names> {}, NICKEL_FWD(defaults))...))
@@ -148,11 +560,47 @@ namespace nickel {
                 return reduce(NICKEL_FWD(extra)...,
                     NICKEL_FWD(storage).get_or_default(tag_t<Names> {}, NICKEL_FWD(defaults))...);
             }
+
+            // Some defaults depend on other arguments, so they are all computed, in dependency
+            // order, before the call: the order in which the function's parameters are
+            // initialized is unspecified.
+            template <typename Fn, typename Storage, typename Defaults, typename... Extra,
+                std::enable_if_t<has_dependencies<remove_cvref_t<Defaults>>::value, int> = 0>
+            static NICKEL_DETAIL_CONSTEXPR20 decltype(auto) map_reduce(
+                Fn&& reduce, Storage&& storage, Defaults&& defaults, Extra&&... extra)
+            {
+                return dependent_call<remove_cvref_t<Storage>, remove_cvref_t<Defaults>,
+                    names_t>::call(NICKEL_FWD(reduce), storage, defaults, NICKEL_FWD(extra)...);
+            }
         };
 
-        // Finds the named<X, Y> in `Nameds` corresponding to `Name`
-        template <typename Name, typename... Nameds>
-        using find_named = typename mp_map_find_impl<Name, Nameds...>::type;
+        template <typename T, typename... Ts>
+        constexpr bool all_same()
+        {
+            constexpr bool same[] = {true, NICKEL_IS_SAME(T, Ts)...};
+            for (bool is_same : same) {
+                if (!is_same) return false;
+            }
+            return true;
+        }
+
+        // The bound value of a multivalued name: a tuple of references to the values for
+        // `.multivalued<N>()`, or their addresses for `.multivalued()`.
+        template <int N, typename... Ts>
+        constexpr std::tuple<Ts&&...> multivalue(int_t<N>, Ts&&... values)
+        {
+            static_assert(N != -2, "A .multivalued() name needs at least one value");
+            return std::tuple<Ts&&...>(NICKEL_FWD(values)...);
+        }
+
+        template <typename T, typename... Ts>
+        constexpr value_refs<remove_cvref_t<T>, sizeof...(Ts) + 1> multivalue(
+            int_t<-2>, T&& value, Ts&&... values)
+        {
+            static_assert(all_same<remove_cvref_t<T>, remove_cvref_t<Ts>...>(),
+                "The values of a .multivalued() name must all have the same type");
+            return {{detail::addressof(value), detail::addressof(values)...}};
+        }
 
         // Marks a constructor.
         // This eliminates the need to use SFINAE to prevent a constructor from subsuming the
@@ -240,6 +688,20 @@ namespace nickel {
             }
         };
 
+        // A kwargs object which refers to the members of an existing object (see nickel::view).
+        // Also provides the `.<name>()` accessors for those members.
+        template <typename Storage, typename Names>
+        class named_view;
+
+        template <typename Storage, typename... Names>
+        class named_view<Storage, names_t<Names...>>
+            : public kwargs<Storage>,
+              public Names::template get_type<named_view<Storage, names_t<Names...>>>...
+        {
+        public:
+            using kwargs<Storage>::kwargs;
+        };
+
         // An unevaluated default argument value
         template <typename Lambda>
         struct deferred : Lambda
@@ -273,58 +735,318 @@ namespace nickel {
             return fn();
         }
 
-        // The currently bound names; that is, the bound arguments.
-        template <typename... Nameds>
-        class storage : private Nameds...
+        // A deferred default argument which is computed from the arguments for `Deps`; see
+        // nickel::deferred(fn, names...). Only names_t::map_reduce knows how to call it.
+        template <typename Lambda, typename... Deps>
+        struct deferred_from : Lambda
         {
-            template <typename Name>
-            using lookup_name = find_named<Name, Nameds...>;
+            template <typename FLambda>
+            constexpr explicit deferred_from(construct_tag, FLambda&& fn)
+                : Lambda(NICKEL_FWD(fn))
+            { }
 
-        public:
-            // Is there already an argument for the given name?
-            template <typename Name>
-            static constexpr bool is_set = !NICKEL_IS_VOID(find_named<Name, Nameds...>);
+            using Lambda::operator();
+        };
 
-            template <typename... FNameds>
-            explicit constexpr storage(construct_tag, FNameds&&... nameds)
-                : Nameds {NICKEL_FWD(nameds)}...
+        template <typename Lambda, typename... Deps>
+        constexpr int get_default(deferred_from<Lambda, Deps...> const&)
+        {
+            static_assert(sizeof(Lambda) == 0,
+                "A default argument computed from other names is not supported for kwargs");
+            return 0;
+        }
+
+        template <typename Lambda, typename... Deps>
+        constexpr int get_default(deferred_from<Lambda, Deps...>&& fn)
+        {
+            return detail::get_default(static_cast<deferred_from<Lambda, Deps...> const&>(fn));
+        }
+
+        // What kind of default argument a `T` is.
+        template <typename T>
+        struct default_traits
+        {
+            static constexpr bool is_deferred = false;
+            using dependencies = names_t<>;
+        };
+
+        template <typename Lambda>
+        struct default_traits<deferred<Lambda>>
+        {
+            static constexpr bool is_deferred = true;
+            using dependencies = names_t<>;
+        };
+
+        template <typename Lambda, typename... Deps>
+        struct default_traits<deferred_from<Lambda, Deps...>>
+        {
+            static constexpr bool is_deferred = true;
+            using dependencies = names_t<Deps...>;
+        };
+
+        // The constructor arguments of a value to construct in place; see nickel::in_place(...).
+        // Converts to any type which the arguments can construct. Since C++17, the conversion's
+        // result initializes the parameter directly, so the value is never moved.
+        template <typename... Args>
+        class in_place_args
+        {
+        public:
+            constexpr explicit in_place_args(construct_tag, Args&&... args)
+                : args_ {NICKEL_FWD(args)...}
             { }
 
-            // Binds `Name` to `value`.
-            template <typename Name, typename T>
-            constexpr auto set(T&& value) &&
+            template <typename T,
+                std::enable_if_t<std::is_constructible<T, Args&&...>::value, int> = 0>
+            constexpr operator T() &&
             {
-                return storage<Nameds..., named<Name, T&&>> {
-                    construct_tag {},
-                    static_cast<Nameds&&>(*this)...,
-                    named<Name, T&&> {NICKEL_FWD(value)},
-                };
+                return NICKEL_MOVE(*this).template construct<T>(std::index_sequence_for<Args...> {});
             }
 
-            // NOT PUBLIC API
-            // Like `set()`, but forces a value instead of a reference.
-            template <typename Name, typename T>
-            constexpr auto _set_value(set_tag, T&& value) &&
+        private:
+            template <typename T, std::size_t... Is>
+            constexpr T construct(std::index_sequence<Is...>) &&
             {
-                return storage<Nameds..., named<Name, T>> {
-                    construct_tag {},
-                    static_cast<Nameds&&>(*this)...,
-                    named<Name, T> {NICKEL_FWD(value)},
-                };
+                return T(static_cast<Args&&>(std::get<Is>(args_))...);
             }
 
-            // Retrieves the requested named<Name, T>
-            template <typename Named>
-            constexpr auto get_named() && -> Named&&
-            {
-                return static_cast<Named&&>(*this);
-            }
+            std::tuple<Args&&...> args_;
+        };
 
-            // Retrieves the named<Name, T> corresponding with Name.
-            template <typename Name>
-            constexpr decltype(auto) lookup_named(tag_t<Name>) &&
-            {
-                static_assert(is_set<Name>, "Name is not set");
+        // A list of types, e.g. the parameter types of a function.
+        template <typename... Ts>
+        struct type_list
+        { };
+
+        template <typename...>
+        using void_t = void;
+
+        // The parameter types of a callable with a fixed signature.
+        // `fixed` is false if the callable is overloaded or generic.
+        template <typename Fn, typename = void>
+        struct fn_signature
+        {
+            static constexpr bool fixed = false;
+            using params = void;
+        };
+
+        template <typename R, typename... Ps>
+        struct fn_signature<R (*)(Ps...)>
+        {
+            static constexpr bool fixed = true;
+            using params = type_list<Ps...>;
+        };
+
+        template <typename R, typename Class, typename... Ps>
+        struct fn_signature<R (Class::*)(Ps...)> : fn_signature<R (*)(Ps...)>
+        { };
+
+        template <typename R, typename Class, typename... Ps>
+        struct fn_signature<R (Class::*)(Ps...) const> : fn_signature<R (*)(Ps...)>
+        { };
+
+#ifdef __cpp_noexcept_function_type
+        template <typename R, typename... Ps>
+        struct fn_signature<R (*)(Ps...) noexcept> : fn_signature<R (*)(Ps...)>
+        { };
+
+        template <typename R, typename Class, typename... Ps>
+        struct fn_signature<R (Class::*)(Ps...) noexcept> : fn_signature<R (*)(Ps...)>
+        { };
+
+        template <typename R, typename Class, typename... Ps>
+        struct fn_signature<R (Class::*)(Ps...) const noexcept> : fn_signature<R (*)(Ps...)>
+        { };
+#endif
+
+        template <typename Fn>
+        struct fn_signature<Fn, void_t<decltype(&Fn::operator())>>
+            : fn_signature<decltype(&Fn::operator())>
+        { };
+
+        // The parameter type of a wrapped function for each of its names, or void if it is not
+        // known: if the function has kwargs, or no single, non-template signature.
+        template <typename Params, typename Kwargs, typename Names>
+        struct param_types
+        {
+            template <typename Name>
+            using type = void;
+        };
+
+        template <typename... Ps, typename... Names>
+        struct param_types<type_list<Ps...>, names_t<>, names_t<Names...>>
+        {
+            template <typename Name>
+            using type = conditional_t<sizeof...(Ps) == sizeof...(Names),
+                std::tuple_element_t<names_t<Names...>::template index_of<Name>(),
+                    std::tuple<Ps..., void>>,
+                void>;
+        };
+
+        // The type which nickel::materialize(...) copies a bound value of type `T` into, for a
+        // parameter of type `Param` (void if unknown).
+        // Derives from std::false_type if the value cannot be kept.
+        template <typename Param, typename T>
+        struct owning_param : std::true_type
+        {
+            using type = owning_t<T>;
+        };
+
+        // The arguments of nickel::in_place(...) may be temporaries which are gone by the time the
+        // call is finished, so the parameter's value is constructed from them in the arena instead.
+        template <typename Param, typename... Args>
+        struct owning_param<Param, in_place_args<Args...>> : std::true_type
+        {
+            using type = remove_cvref_t<Param>;
+        };
+
+        template <typename... Args>
+        struct owning_param<void, in_place_args<Args...>> : std::false_type
+        {
+            using type = in_place_args<Args...>;
+        };
+
+        template <typename Param, typename T>
+        using owning_param_t = typename owning_param<Param, remove_cvref_t<T>>::type;
+
+        // Reported instead of materializing, so that the static_assert is the only error.
+        template <typename Fn>
+        struct unknown_in_place_param
+        {
+            static_assert(sizeof(Fn) == 0,
+                "nickel::materialize(...) can only construct a nickel::in_place(...) argument for a "
+                "function with a single, non-template signature and no kwargs");
+        };
+
+        // Where each bound argument goes in the canonical layout of a storage<...>: each name at
+        // its position in `Order`, and names which aren't in `Order` (see nickel::rest) last, in
+        // the order they were bound. `positions[I]` is the index in `Bound` of the argument at I.
+        template <std::size_t N>
+        struct layout_t
+        {
+            std::size_t positions[N];
+        };
+
+        template <typename Order, typename... Bound>
+        constexpr layout_t<sizeof...(Bound) + 1> canonical_layout(names_t<Bound...>)
+        {
+            constexpr std::size_t keys[] = {Order::template index_of<Bound>()..., 0};
+            constexpr std::size_t count = sizeof...(Bound);
+
+            layout_t<sizeof...(Bound) + 1> layout {};
+            for (std::size_t i = 0; i != count; ++i) {
+                std::size_t position = 0;
+                for (std::size_t j = 0; j != count; ++j) {
+                    position += keys[j] < keys[i] || (keys[j] == keys[i] && j < i);
+                }
+                layout.positions[position] = i;
+            }
+            return layout;
+        }
+
+        template <typename Order, typename Bound>
+        struct canonical_layout_of
+        {
+            static constexpr auto value = detail::canonical_layout<Order>(Bound {});
+        };
+
+        template <typename... Nameds>
+        class storage;
+
+        // The storage<...> with the arguments of `Storage` laid out in canonical order.
+        template <typename Order, typename Storage,
+            typename = std::make_index_sequence<Storage::bound_names::count>>
+        struct canonical_storage;
+
+        template <typename Order, typename... Nameds, std::size_t... Is>
+        struct canonical_storage<Order, storage<Nameds...>, std::index_sequence<Is...>>
+        {
+            using layout = canonical_layout_of<Order, names_t<typename Nameds::name_type...>>;
+            using type
+                = storage<typename names_t<Nameds...>::template at<layout::value.positions[Is]>...>;
+        };
+
+        // The currently bound names; that is, the bound arguments.
+        template <typename... Nameds>
+        class storage : private Nameds...
+        {
+            template <typename...>
+            friend class storage;
+
+            template <typename Name>
+            using lookup_name = decltype(detail::base_named<Name>(static_cast<storage*>(nullptr)));
+
+            // The type which `_materialize(...)` copies the value of `Named` into.
+            template <typename Params, typename Named>
+            using owned_t = owning_param_t<
+                typename Params::template type<typename Named::name_type>,
+                typename Named::value_type>;
+
+        public:
+            // The bound names, in the order they were bound.
+            using bound_names = names_t<typename Nameds::name_type...>;
+
+            // Is there already an argument for the given name?
+            template <typename Name>
+            static constexpr bool is_set = !NICKEL_IS_VOID(lookup_name<Name>);
+
+            template <typename... FNameds>
+            NICKEL_DETAIL_INLINE explicit constexpr storage(construct_tag, FNameds&&... nameds)
+                : Nameds {NICKEL_FWD(nameds)}...
+            { }
+
+            // Takes each of our arguments from `source`, which has the same ones in another order.
+            template <typename... SourceNameds>
+            NICKEL_DETAIL_INLINE explicit constexpr storage(
+                priv_tag, storage<SourceNameds...>&& source)
+                : Nameds {static_cast<Nameds&&>(source)}...
+            { }
+
+            // Binds `Name` to `value`.
+            template <typename Name, typename T>
+            NICKEL_DETAIL_INLINE constexpr auto set(T&& value) &&
+            {
+                return storage<Nameds..., named<Name, T&&>> {
+                    construct_tag {},
+                    static_cast<Nameds&&>(*this)...,
+                    named<Name, T&&> {NICKEL_FWD(value)},
+                };
+            }
+
+            // Binds each of the Names to the corresponding value, all at once.
+            template <typename... Names, typename... Ts>
+            NICKEL_DETAIL_INLINE constexpr auto set_all(names_t<Names...>, Ts&&... values) &&
+            {
+                return storage<Nameds..., named<Names, Ts&&>...> {
+                    construct_tag {},
+                    static_cast<Nameds&&>(*this)...,
+                    named<Names, Ts&&> {NICKEL_FWD(values)}...,
+                };
+            }
+
+            // NOT PUBLIC API
+            // Like `set()`, but forces a value instead of a reference.
+            template <typename Name, typename T>
+            NICKEL_DETAIL_INLINE constexpr auto _set_value(set_tag, T&& value) &&
+            {
+                return storage<Nameds..., named<Name, T>> {
+                    construct_tag {},
+                    static_cast<Nameds&&>(*this)...,
+                    named<Name, T> {NICKEL_FWD(value)},
+                };
+            }
+
+            // Retrieves the requested named<Name, T>
+            template <typename Named>
+            constexpr auto get_named() && -> Named&&
+            {
+                return static_cast<Named&&>(*this);
+            }
+
+            // Retrieves the named<Name, T> corresponding with Name.
+            template <typename Name>
+            constexpr decltype(auto) lookup_named(tag_t<Name>) &&
+            {
+                static_assert(is_set<Name>, "Name is not set");
                 using Named = lookup_name<Name>;
 
                 return static_cast<Named&&>(*this);
@@ -333,7 +1055,7 @@ namespace nickel {
             // Combines our bound arguments with `other`'s bound arguments, producing a `storage<>`
             // with both.
             template <typename... OtherNameds>
-            constexpr auto combine(storage<OtherNameds...>&& other) &&
+            NICKEL_DETAIL_INLINE constexpr auto combine(storage<OtherNameds...>&& other) &&
             {
                 return storage<Nameds..., OtherNameds...> {
                     construct_tag {},
@@ -342,6 +1064,27 @@ namespace nickel {
                 };
             }
 
+            // Retrieves the bound value associated with the Name, without consuming it.
+            template <typename Name>
+            constexpr decltype(auto) get(tag_t<Name>) &
+            {
+                static_assert(is_set<Name>, "Name is not set");
+                using Named = lookup_name<Name>;
+                // Spelled out, as GCC deduces an rvalue reference for a member bound by one.
+                using value_ref = std::remove_reference_t<typename Named::value_type>&;
+
+                return static_cast<value_ref>(static_cast<Named&>(*this).value);
+            }
+
+            template <typename Name>
+            constexpr decltype(auto) get(tag_t<Name>) const&
+            {
+                static_assert(is_set<Name>, "Name is not set");
+                using Named = lookup_name<Name>;
+
+                return (static_cast<Named const&>(*this).value);
+            }
+
             // Retrieves the bound value associated with the Name.
             template <typename Name>
             constexpr decltype(auto) get(tag_t<Name> id) &&
@@ -351,228 +1094,1454 @@ namespace nickel {
                 return NICKEL_FWD(NICKEL_MOVE(*this).lookup_named(id).value);
             }
 
-#ifdef __cpp_if_constexpr
-            // Retrieves the bound value associated with the Name, else falls back on retrieving
-            // from `defaults`.
-            template <typename Name, typename Defaults>
-            constexpr decltype(auto) get_or_default(tag_t<Name> id, Defaults&& defaults) &&
-            {
-                if constexpr (is_set<Name>) {
-                    return NICKEL_MOVE(*this).get(id);
-                } else {
-                    return detail::get_default(NICKEL_FWD(defaults).get(id));
-                }
-            }
-#else
-            template <typename Name, typename Defaults>
-            constexpr decltype(auto) get_or_default_(
-                std::false_type, tag_t<Name> id, Defaults&& defaults) &&
-            {
-                return detail::get_default(NICKEL_FWD(defaults).get(id));
+            // Retrieves the bound value associated with the Name, else falls back on retrieving
+            // from `defaults`.
+            template <typename Name, typename Defaults>
+            constexpr decltype(auto) get_or_default(tag_t<Name>, Defaults&& defaults) &&
+            {
+                // One overload resolution decides between the two, rather than looking Name up
+                // once to see if it is set and again to get it.
+                return storage::get_or_default_<Name>(this, NICKEL_FWD(defaults));
+            }
+
+            // Name is bound: `this` converts to a pointer to our named<Name, T> base, which is a
+            // better conversion than to void*.
+            template <typename Name, typename T, typename Defaults>
+            static constexpr T&& get_or_default_(named<Name, T>* bound, Defaults&&)
+            {
+                return static_cast<T&&>(bound->value);
+            }
+
+            // The arguments of a `.multivalued()` name are passed as a values<T>, whatever their
+            // number.
+            template <typename Name, typename T, std::size_t K, typename Defaults>
+            static constexpr values<T> get_or_default_(
+                named<Name, value_refs<T, K>>* bound, Defaults&&)
+            {
+                return bound->value.view();
+            }
+
+            template <typename Name, typename T, std::size_t K, typename Defaults>
+            static values<T> get_or_default_(named<Name, owned_values<T, K>&&>* bound, Defaults&&)
+            {
+                return bound->value.view();
+            }
+
+            template <typename Name, typename Defaults>
+            static constexpr decltype(auto) get_or_default_(void*, Defaults&& defaults)
+            {
+                return detail::get_default(NICKEL_FWD(defaults).get(tag_t<Name> {}));
+            }
+
+            // NOT PUBLIC API
+            // TODO: figure out how to enforce non-public API.
+            // TODO: figure out precisely what this does.
+            template <typename... Names, typename Defaults>
+            constexpr decltype(auto) get(tag_t<names_t<Names...>>, Defaults&& defaults) &&
+            {
+                using kwargs_storage_t = storage<lookup_name<Names>...>;
+                return kwargs<kwargs_storage_t> {
+                    construct_tag {},
+                    kwargs_storage_t {
+                        construct_tag {},
+                        NICKEL_MOVE(*this).get_or_default(tag_t<Names> {}, NICKEL_FWD(defaults))...,
+                    },
+                };
+            }
+
+            // NOT PUBLIC API
+            // Our arguments, laid out in the canonical order for `Order` (see canonical_layout).
+            // However the arguments were set, the same arguments produce the same storage<...>.
+            template <typename Order>
+            constexpr auto _canonical(priv_tag, tag_t<Order>) &&
+            {
+                using canonical_t = typename canonical_storage<Order, storage>::type;
+                return canonical_t {priv_tag {}, NICKEL_MOVE(*this)};
+            }
+
+            // NOT PUBLIC API
+            // Keeps the Declared arguments, and moves the Others into a kwargs bound to `Rest`.
+            // Declared and Others must partition our Nameds (see split_rest).
+            template <typename Rest, typename... Declared, typename... Others>
+            constexpr auto _split_rest(priv_tag, tag_t<Rest>, tag_t<storage<Declared...>>,
+                tag_t<storage<Others...>>) &&
+            {
+                using rest_t = kwargs<storage<Others...>>;
+                return storage<Declared..., named<Rest, rest_t>> {
+                    construct_tag {},
+                    static_cast<Declared&&>(*this)...,
+                    named<Rest, rest_t> {rest_t {
+                        construct_tag {},
+                        storage<Others...> {construct_tag {}, static_cast<Others&&>(*this)...},
+                    }},
+                };
+            }
+
+            // NOT PUBLIC API
+            // Whether `_materialize(...)` can keep every bound value (see owning_param).
+            template <typename Params>
+            static constexpr bool _materializable(priv_tag)
+            {
+                constexpr bool known[] = {true,
+                    owning_param<typename Params::template type<typename Nameds::name_type>,
+                        remove_cvref_t<typename Nameds::value_type>>::value...};
+                for (bool is_known : known) {
+                    if (!is_known) return false;
+                }
+                return true;
+            }
+
+            // NOT PUBLIC API
+            // Copies each bound value into `arena`, producing a storage which refers to the copies.
+            // `Params` gives the parameter type for each name (see param_types).
+            // The copies must later be destroyed with `_destroy(...)`.
+            template <typename Params, typename Arena>
+            auto _materialize(priv_tag, tag_t<Params>, Arena& arena) &&
+            {
+                using materialized_t = storage<named<typename Nameds::name_type,
+                    owned_t<Params, Nameds>&&>...>;
+
+                arena_rollback<sizeof...(Nameds)> rollback;
+                // Braced initialization: the copies are made in order, so `rollback` stays accurate.
+                materialized_t result {
+                    construct_tag {},
+                    named<typename Nameds::name_type, owned_t<Params, Nameds>&&> {
+                        NICKEL_MOVE(rollback.template emplace<owned_t<Params, Nameds>>(
+                            arena, NICKEL_FWD(static_cast<Nameds&&>(*this).value))),
+                    }...,
+                };
+                rollback.release();
+
+                return result;
+            }
+
+            // NOT PUBLIC API
+            // Destroys the values bound in this storage. Only valid for a `_materialize(...)` result.
+            void _destroy(priv_tag) & noexcept
+            {
+                int expand[] = {0, (detail::destroy_value(static_cast<Nameds&>(*this).value), 0)...};
+                (void)expand;
+            }
+        };
+
+        // Provide the .<name>() member iff the parameter hasn't been set before.
+        template <typename Storage, typename Name, typename CRTP>
+        using allow_set_only_if_unset = conditional_t<Storage::template is_set<Name>, tag_t<Name>,
+            typename Name::template set_type<CRTP>>;
+
+        // The position of the first of the Names which has neither an argument in `Storage` nor a
+        // default in `Defaults`, or `sizeof...(Names)` if every name has a value.
+        template <typename Storage, typename Defaults, typename... Names>
+        constexpr std::size_t first_unbound(names_t<Names...>)
+        {
+            constexpr bool bound[] = {
+                (Storage::template is_set<Names> || Defaults::template is_set<Names>)..., false};
+
+            std::size_t index = 0;
+            while (bound[index]) ++index;
+
+            return index;
+        }
+
+        // The position of the first of the Names which already has an argument in `Storage`, or
+        // `sizeof...(Names)` if none do.
+        template <typename Storage, typename... Names>
+        constexpr std::size_t first_bound(names_t<Names...>)
+        {
+            constexpr bool bound[] = {Storage::template is_set<Names>..., true};
+
+            std::size_t index = 0;
+            while (!bound[index]) ++index;
+
+            return index;
+        }
+
+        // Calls which cannot be made are reported through these, so that the diagnostic names the
+        // offending Name (in the "in instantiation of" note) and nothing further is instantiated.
+        template <typename Name>
+        struct missing_argument
+        {
+            static_assert(sizeof(Name) == 0,
+                "No argument was given for this name, and it has no default value");
+        };
+
+        template <typename Name>
+        struct duplicate_argument
+        {
+            static_assert(sizeof(Name) == 0,
+                "This name already has an argument; it cannot be passed again through kwargs");
+        };
+
+        // The result of a call which failed one of the checks above. Can be called and converts to
+        // anything, so that the static_assert is the only error.
+        struct invalid_call
+        {
+            template <typename... Ts>
+            constexpr invalid_call operator()(Ts&&...) const
+            {
+                return {};
+            }
+
+            template <typename T>
+            operator T() const;
+        };
+
+        template <typename... Ts>
+        constexpr bool any_dependencies()
+        {
+            constexpr bool dependent[] = {false, (default_traits<Ts>::dependencies::count != 0)...};
+            for (bool is_dependent : dependent) {
+                if (is_dependent) return true;
+            }
+            return false;
+        }
+
+        template <typename... Nameds>
+        struct has_dependencies<storage<Nameds...>>
+            : std::integral_constant<bool,
+                  detail::any_dependencies<remove_cvref_t<typename Nameds::value_type>...>()>
+        { };
+
+        // Which of the `Names` a default argument's dependencies `Deps` are: `names[J]` is whether
+        // the default uses the argument for the Jth of the Names.
+        template <std::size_t N>
+        struct dependency_row_t
+        {
+            bool names[N];
+            // Whether it uses a name which isn't one of the Names.
+            bool unknown;
+        };
+
+        template <typename... Deps, typename... Names>
+        constexpr dependency_row_t<sizeof...(Names) + 1> dependency_row(
+            names_t<Deps...>, names_t<Names...>)
+        {
+            constexpr bool known[] = {names_t<Names...>::template contains<Deps>..., true};
+
+            dependency_row_t<sizeof...(Names) + 1> row {
+                {names_t<Deps...>::template contains<Names>..., false},
+                false,
+            };
+            for (bool is_known : known) {
+                row.unknown = row.unknown || !is_known;
+            }
+            return row;
+        }
+
+        // An order of the Names in which every default comes after the names it depends on.
+        // `positions[I]` is the index in the Names of the Ith name to compute.
+        template <std::size_t N>
+        struct dependency_order_t
+        {
+            std::size_t positions[N];
+            // The index of a name whose default depends on a name the function doesn't take, or
+            // N - 1 if there is none.
+            std::size_t unknown;
+            // The index of a name in a dependency cycle, or N - 1 if there is none.
+            std::size_t cycle;
+        };
+
+        template <typename Defaults, typename Name, bool = Defaults::template is_set<Name>>
+        struct dependencies_of
+        {
+            using type = names_t<>;
+        };
+
+        template <typename Defaults, typename Name>
+        struct dependencies_of<Defaults, Name, true>
+        {
+            using type = typename default_traits<remove_cvref_t<decltype(
+                std::declval<Defaults&>().get(tag_t<Name> {}))>>::dependencies;
+        };
+
+        template <typename Defaults, typename... Names>
+        constexpr dependency_order_t<sizeof...(Names) + 1> dependency_order(names_t<Names...>)
+        {
+            constexpr std::size_t count = sizeof...(Names);
+            constexpr dependency_row_t<count + 1> depends[] = {
+                detail::dependency_row(
+                    typename dependencies_of<Defaults, Names>::type {}, names_t<Names...> {})...,
+                {},
+            };
+
+            dependency_order_t<count + 1> order {{}, count, count};
+            for (std::size_t i = 0; i != count; ++i) {
+                if (depends[i].unknown && order.unknown == count) order.unknown = i;
+            }
+
+            bool placed[count + 1] = {};
+            for (std::size_t position = 0; position != count; ++position) {
+                // The first name whose dependencies have all been placed.
+                std::size_t next = 0;
+                for (; next != count; ++next) {
+                    bool ready = !placed[next];
+                    for (std::size_t j = 0; j != count; ++j) {
+                        ready = ready && (placed[j] || !depends[next].names[j]);
+                    }
+                    if (ready) break;
+                }
+
+                if (next == count) {
+                    // Every name left depends on another name left, so following those
+                    // dependencies for long enough ends up in a cycle.
+                    std::size_t name = 0;
+                    while (placed[name]) ++name;
+                    for (std::size_t step = 0; step != count; ++step) {
+                        std::size_t dependency = 0;
+                        while (placed[dependency] || !depends[name].names[dependency]) {
+                            ++dependency;
+                        }
+                        name = dependency;
+                    }
+                    order.cycle = name;
+                    return order;
+                }
+
+                placed[next] = true;
+                order.positions[position] = next;
+            }
+            return order;
+        }
+
+        template <typename Defaults, typename Names>
+        struct dependency_order_of
+        {
+            static constexpr auto value = detail::dependency_order<Defaults>(Names {});
+        };
+
+        template <typename Name>
+        struct unknown_dependency
+        {
+            static_assert(sizeof(Name) == 0,
+                "The default argument for this name is computed from a name which the function "
+                "does not take");
+        };
+
+        template <typename Name>
+        struct dependency_cycle
+        {
+            static_assert(sizeof(Name) == 0,
+                "The default argument for this name is computed from itself, through the names "
+                "passed to nickel::deferred(fn, names...)");
+        };
+
+        // A default computed before the call. Empty until constructed.
+        template <typename Name, typename T>
+        class resolved_slot
+        {
+        public:
+            NICKEL_DETAIL_CONSTEXPR20 resolved_slot() noexcept
+            { }
+
+            resolved_slot(resolved_slot const&) = delete;
+            resolved_slot& operator=(resolved_slot const&) = delete;
+
+            NICKEL_DETAIL_CONSTEXPR20 ~resolved_slot()
+            {
+                if (constructed_) value_.~T();
+            }
+
+            template <typename Fn, typename... Args>
+            NICKEL_DETAIL_CONSTEXPR20 void construct(Fn& fn, Args&... args)
+            {
+#if defined(__cpp_lib_constexpr_dynamic_alloc)
+                std::construct_at(std::addressof(value_), fn(args...));
+#else
+                ::new (static_cast<void*>(std::addressof(value_))) T(fn(args...));
+#endif
+                constructed_ = true;
+            }
+
+            NICKEL_DETAIL_CONSTEXPR20 T& get() noexcept
+            {
+                return value_;
+            }
+
+        private:
+            union
+            {
+                T value_;
+            };
+            bool constructed_ = false;
+        };
+
+        // Where the argument for `Name` comes from in a call with dependent defaults.
+        // `ref` is how it is passed to the defaults which depend on it, and `value` the type of
+        // its resolved_slot, or void if it doesn't need one.
+        template <typename Storage, typename Defaults, typename Name,
+            bool = Storage::template is_set<Name>, bool = Defaults::template is_set<Name>>
+        struct resolved_arg
+        {
+            // No argument: a kwargs name, which map_reduce doesn't see.
+            using dependencies = names_t<>;
+            static constexpr bool is_deferred = false;
+            using ref = void;
+            using value = void;
+        };
+
+        template <typename Storage, typename Defaults, typename Name, bool HasDefault>
+        struct resolved_arg<Storage, Defaults, Name, true, HasDefault>
+        {
+            using dependencies = names_t<>;
+            static constexpr bool is_deferred = false;
+            using ref = decltype(std::declval<Storage&>().get(tag_t<Name> {}));
+            using value = void;
+        };
+
+        template <typename Storage, typename Defaults, typename Name,
+            typename Default
+            = remove_cvref_t<decltype(std::declval<Defaults&>().get(tag_t<Name> {}))>>
+        struct resolved_default
+        {
+            using dependencies = names_t<>;
+            static constexpr bool is_deferred = false;
+            using ref = decltype(std::declval<Defaults&>().get(tag_t<Name> {}));
+            using value = void;
+        };
+
+        template <typename Storage, typename Defaults, typename Name, typename Lambda>
+        struct resolved_default<Storage, Defaults, Name, deferred<Lambda>>
+        {
+            using dependencies = names_t<>;
+            static constexpr bool is_deferred = true;
+            using value = std::decay_t<decltype(std::declval<Lambda&>()())>;
+            using ref = value&;
+        };
+
+        template <typename Storage, typename Defaults, typename Name, typename Lambda,
+            typename... Deps>
+        struct resolved_default<Storage, Defaults, Name, deferred_from<Lambda, Deps...>>
+        {
+            using dependencies = names_t<Deps...>;
+            static constexpr bool is_deferred = true;
+            using value = std::decay_t<decltype(std::declval<Lambda&>()(
+                std::declval<typename resolved_arg<Storage, Defaults, Deps>::ref>()...))>;
+            using ref = value&;
+        };
+
+        template <typename Storage, typename Defaults, typename Name>
+        struct resolved_arg<Storage, Defaults, Name, false, true>
+            : resolved_default<Storage, Defaults, Name>
+        { };
+
+        // Is an unset default computed before the call? Dependent defaults are, as are the
+        // deferred defaults which they use; an argument for a name skips its default entirely.
+        template <typename Storage, typename Defaults, typename Name, typename... Names>
+        constexpr bool is_resolved(names_t<Names...>)
+        {
+            using arg = resolved_arg<Storage, Defaults, Name>;
+            constexpr bool used[] = {arg::dependencies::count != 0,
+                resolved_arg<Storage, Defaults, Names>::dependencies::template contains<Name>...};
+
+            if (!arg::is_deferred) return false;
+            for (bool is_used : used) {
+                if (is_used) return true;
+            }
+            return false;
+        }
+
+        template <typename Storage, typename Defaults, typename Names, typename Name>
+        using resolved_slot_t
+            = conditional_t<detail::is_resolved<Storage, Defaults, Name>(Names {}),
+                resolved_slot<Name, typename resolved_arg<Storage, Defaults, Name>::value>,
+                tag_t<Name>>;
+
+        // The defaults of a call, once those computed before the call have been.
+        template <typename Storage, typename Defaults, typename Names>
+        class resolved_defaults;
+
+        template <typename Storage, typename Defaults, typename... Names>
+        class resolved_defaults<Storage, Defaults, names_t<Names...>>
+            : private resolved_slot_t<Storage, Defaults, names_t<Names...>, Names>...
+        {
+        public:
+            NICKEL_DETAIL_CONSTEXPR20 explicit resolved_defaults(
+                Storage& storage, Defaults& defaults) noexcept
+                : storage_ {storage}
+                , defaults_ {defaults}
+            { }
+
+            // Computes each default which needs it, in dependency order.
+            template <std::size_t... Is>
+            NICKEL_DETAIL_CONSTEXPR20 void resolve(std::index_sequence<Is...>)
+            {
+                using order = dependency_order_of<Defaults, names_t<Names...>>;
+                int expand[] = {0,
+                    (resolve_<typename names_t<Names...>::template at<order::value.positions[Is]>>(
+                         this),
+                        0)...};
+                (void)expand;
+            }
+
+            // The argument for the parameter `Name`.
+            template <typename Name>
+            NICKEL_DETAIL_CONSTEXPR20 decltype(auto) take(tag_t<Name>)
+            {
+                return take_<Name>(this);
+            }
+
+        private:
+            Storage& storage_;
+            Defaults& defaults_;
+
+            template <typename Name, typename T>
+            NICKEL_DETAIL_CONSTEXPR20 void resolve_(resolved_slot<Name, T>* slot)
+            {
+                construct_(*slot, defaults_.get(tag_t<Name> {}));
+            }
+
+            template <typename Name>
+            NICKEL_DETAIL_CONSTEXPR20 void resolve_(void*)
+            { }
+
+            template <typename Name, typename T, typename Lambda>
+            NICKEL_DETAIL_CONSTEXPR20 void construct_(
+                resolved_slot<Name, T>& slot, deferred<Lambda>& fn)
+            {
+                slot.construct(fn);
+            }
+
+            template <typename Name, typename T, typename Lambda, typename... Deps>
+            NICKEL_DETAIL_CONSTEXPR20 void construct_(
+                resolved_slot<Name, T>& slot, deferred_from<Lambda, Deps...>& fn)
+            {
+                slot.construct(fn, ref_<Deps>(this)...);
+            }
+
+            // The argument for a dependency, which has already been computed if it needed to be.
+            template <typename Name, typename T>
+            NICKEL_DETAIL_CONSTEXPR20 T& ref_(resolved_slot<Name, T>* slot)
+            {
+                return slot->get();
+            }
+
+            template <typename Name>
+            NICKEL_DETAIL_CONSTEXPR20 decltype(auto) ref_(void*)
+            {
+                return ref_<Name>(
+                    std::integral_constant<bool, Storage::template is_set<Name>> {});
+            }
+
+            template <typename Name>
+            NICKEL_DETAIL_CONSTEXPR20 decltype(auto) ref_(std::true_type /* is set */)
+            {
+                return storage_.get(tag_t<Name> {});
+            }
+
+            template <typename Name>
+            NICKEL_DETAIL_CONSTEXPR20 decltype(auto) ref_(std::false_type /* is set */)
+            {
+                return defaults_.get(tag_t<Name> {});
+            }
+
+            template <typename Name, typename T>
+            NICKEL_DETAIL_CONSTEXPR20 T&& take_(resolved_slot<Name, T>* slot)
+            {
+                return NICKEL_MOVE(slot->get());
+            }
+
+            template <typename Name>
+            NICKEL_DETAIL_CONSTEXPR20 decltype(auto) take_(void*)
+            {
+                return static_cast<Storage&&>(storage_).get_or_default(
+                    tag_t<Name> {}, static_cast<Defaults&&>(defaults_));
+            }
+        };
+
+        template <typename Storage, typename Defaults, typename... Names>
+        struct dependent_call<Storage, Defaults, names_t<Names...>>
+        {
+            static constexpr std::size_t count = sizeof...(Names);
+
+            // Checked before computing the types of the defaults, which recurses forever in a
+            // cycle, so that a cycle is one error.
+            template <typename Fn, typename... Extra>
+            static NICKEL_DETAIL_CONSTEXPR20 decltype(auto) call(
+                Fn&& reduce, Storage& storage, Defaults& defaults, Extra&&... extra)
+            {
+                using order = dependency_order_of<Defaults, names_t<Names...>>;
+                return call_(std::integral_constant<std::size_t, order::value.unknown> {},
+                    std::integral_constant<std::size_t, order::value.cycle> {}, NICKEL_FWD(reduce),
+                    storage, defaults, NICKEL_FWD(extra)...);
+            }
+
+        private:
+            template <typename Fn, typename... Extra>
+            static NICKEL_DETAIL_CONSTEXPR20 decltype(auto) call_(
+                std::integral_constant<std::size_t, count>,
+                std::integral_constant<std::size_t, count>, Fn&& reduce, Storage& storage,
+                Defaults& defaults, Extra&&... extra)
+            {
+                resolved_defaults<Storage, Defaults, names_t<Names...>> resolved {
+                    storage, defaults};
+                resolved.resolve(std::make_index_sequence<count> {});
+
+                return NICKEL_FWD(reduce)(NICKEL_FWD(extra)..., resolved.take(tag_t<Names> {})...);
+            }
+
+            template <std::size_t I, typename Fn, typename... Extra>
+            static invalid_call call_(std::integral_constant<std::size_t, count>,
+                std::integral_constant<std::size_t, I>, Fn&&, Storage&, Defaults&, Extra&&...)
+            {
+                using name = typename names_t<Names...>::template at<I>;
+                return (void)dependency_cycle<name> {}, invalid_call {};
+            }
+
+            template <std::size_t I, std::size_t J, typename Fn, typename... Extra>
+            static invalid_call call_(std::integral_constant<std::size_t, I>,
+                std::integral_constant<std::size_t, J>, Fn&&, Storage&, Defaults&, Extra&&...)
+            {
+                using name = typename names_t<Names...>::template at<I>;
+                return (void)unknown_dependency<name> {}, invalid_call {};
+            }
+        };
+
+        // Unwraps the names_t<...> Kwargs and Names parameters of the wrapped_fn.
+        template <typename Derived, typename Storage, typename Kwargs, typename Names>
+        struct wrapped_fn_base;
+
+        template <typename Derived, typename Storage, typename... Kwargs, typename... Names>
+        struct wrapped_fn_base<Derived, Storage, names_t<Kwargs...>, names_t<Names...>>
+            : // Provide .<name>() members for kwargs.
+              public allow_set_only_if_unset<Storage, Kwargs, Derived>...,
+              // Provide .<name>() members for named parameters.
+              public allow_set_only_if_unset<Storage, Names, Derived>...
+        { };
+
+        template <typename Defaults, typename Storage, typename Fn, typename Kwargs, typename Names,
+            typename CallEvalPolicy>
+        class materialized_fn;
+
+        template <typename Name, typename Value>
+        struct defaulted;
+
+        // The pseudo-name of the nickel::rest parameter.
+        struct rest_name
+        {
+            using name_type = rest_name;
+
+            // No setter: arguments reach the rest parameter through `(name = value)`.
+            template <typename Derived>
+            struct set_type
+            { };
+        };
+
+        // Concatenates storage<...> types.
+        template <typename... Storages>
+        struct storage_cat
+        {
+            using type = storage<>;
+        };
+
+        template <typename... Nameds>
+        struct storage_cat<storage<Nameds...>>
+        {
+            using type = storage<Nameds...>;
+        };
+
+        template <typename... Lhs, typename... Rhs, typename... Rest>
+        struct storage_cat<storage<Lhs...>, storage<Rhs...>, Rest...>
+            : storage_cat<storage<Lhs..., Rhs...>, Rest...>
+        { };
+
+        // Partitions the arguments of `Storage` into those for the `Declared` names and the rest.
+        template <typename Declared, typename Storage>
+        struct split_rest;
+
+        template <typename Declared, typename... Nameds>
+        struct split_rest<Declared, storage<Nameds...>>
+        {
+            using declared = typename storage_cat<conditional_t<
+                Declared::template contains<typename Nameds::name_type>, storage<Nameds>,
+                storage<>>...>::type;
+            using rest = typename storage_cat<conditional_t<
+                Declared::template contains<typename Nameds::name_type>, storage<>,
+                storage<Nameds>>...>::type;
+        };
+
+        // Appends each of the Rest to Unique, unless it is already there.
+        template <typename Unique, typename... Rest>
+        struct unique_names
+        {
+            using type = Unique;
+        };
+
+        template <typename Unique, typename Name, typename... Rest>
+        struct unique_names<Unique, Name, Rest...>
+            : unique_names<conditional_t<Unique::template contains<Name>, Unique,
+                               typename Unique::template append<Name>>,
+                  Rest...>
+        { };
+
+        // Does a function with these Kwargs and Names take all of the Args?
+        template <typename Kwargs, typename Names, typename... Args>
+        constexpr bool all_accepted(names_t<Args...>)
+        {
+            constexpr bool accepted[] = {true,
+                (Kwargs::template contains<Args> || Names::template contains<Args>
+                    || Names::template contains<rest_name>)...};
+            for (bool is_accepted : accepted) {
+                if (!is_accepted) return false;
+            }
+            return true;
+        }
+
+        // wrapped_fn is the main workhorse of Nickel.
+
+        // The in-progress function call sequence.
+        template <typename Defaults, // The default arguments
+            typename Storage, // Any currently bound arguments
+            typename Fn, // The actual function we are wrapping (which we will call)
+            typename Kwargs, // Any Kwargs
+            typename Names, // The explicit named parameters
+            typename CallEvalPolicy> // How to implement calling `Fn`.
+        class wrapped_fn : public wrapped_fn_base<
+                               wrapped_fn<Defaults, Storage, Fn, Kwargs, Names, CallEvalPolicy>,
+                               Storage, Kwargs, Names>
+        {
+        private:
+            Defaults defaults_;
+            Storage storage_;
+            Fn fn_;
+
+        public:
+            template <typename FDefaults, typename FFn>
+            NICKEL_DETAIL_INLINE explicit constexpr wrapped_fn(
+                FDefaults&& defaults, Storage&& storage, FFn&& fn)
+                : defaults_ {NICKEL_FWD(defaults)}
+                , storage_ {NICKEL_MOVE(storage)}
+                , fn_ {NICKEL_FWD(fn)}
+            { }
+
+            // Bind the name to the multi-valued argument.
+            // NOT PUBLIC API
+            // TODO: figure out how to enforce the NOT PUBLIC API
+            template <typename Name, int N, typename... Ts>
+            NICKEL_DETAIL_INLINE constexpr auto operator()(
+                set_tag, Name, int_t<N>, Ts&&... values) &&
+            {
+                using NewStorage = decltype(NICKEL_MOVE(storage_).template _set_value<Name>(
+                    set_tag {}, multivalue(int_t<N> {}, NICKEL_FWD(values)...)));
+                return wrapped_fn<Defaults, NewStorage, remove_cvref_t<Fn>, Kwargs, Names,
+                    CallEvalPolicy> {
+                    NICKEL_MOVE(defaults_),
+                    NICKEL_MOVE(storage_).template _set_value<Name>(
+                        set_tag {}, multivalue(int_t<N> {}, NICKEL_FWD(values)...)),
+                    NICKEL_MOVE(fn_),
+                };
+            }
+
+            // Bind the name to the single argument.
+            // NOT PUBLIC API
+            // TODO: figure out how to enforce the NOT PUBLIC API
+            template <typename Name, typename T>
+            NICKEL_DETAIL_INLINE constexpr auto operator()(set_tag, Name, int_t<-1>, T&& value) &&
+            {
+                using NewStorage
+                    = decltype(NICKEL_MOVE(storage_).template set<Name>(NICKEL_FWD(value)));
+                return wrapped_fn<Defaults, NewStorage, remove_cvref_t<Fn>, Kwargs, Names,
+                    CallEvalPolicy> {
+                    NICKEL_MOVE(defaults_),
+                    NICKEL_MOVE(storage_).template set<Name>(NICKEL_FWD(value)),
+                    NICKEL_MOVE(fn_),
+                };
+            }
+
+            // Bind the kwargs
+            // NOT PUBLIC API
+            // TODO: figure out how to enforce the NOT PUBLIC API
+            template <typename OtherStorage>
+            constexpr auto operator()(kwargs<OtherStorage>&& kwargs) &&
+            {
+                using other_names = typename OtherStorage::bound_names;
+                return NICKEL_MOVE(*this).bind_kwargs_(NICKEL_MOVE(kwargs),
+                    std::integral_constant<bool,
+                        detail::first_bound<Storage>(other_names {}) == other_names::count> {});
+            }
+
+            // Bind a copy of the kwargs, e.g. a nickel::view(...) which is used several times.
+            template <typename OtherStorage>
+            constexpr auto operator()(kwargs<OtherStorage> const& kwargs) &&
+            {
+                return NICKEL_MOVE(*this)(detail::kwargs<OtherStorage>(kwargs));
+            }
+
+            // Bind `(name1 = value1, name2 = value2, ...)`: our names, or any other names if we
+            // take nickel::rest. Unlike chained setters, this makes a single storage for them all.
+            // Like the setters, this refers to the values rather than copying them again.
+            template <typename... ArgNames, typename... Values>
+            constexpr auto operator()(defaulted<ArgNames, Values>&&... args) &&
+            {
+                using arg_names = names_t<ArgNames...>;
+                constexpr bool accepted = detail::all_accepted<Kwargs, Names>(arg_names {});
+                constexpr bool unset
+                    = detail::first_bound<Storage>(arg_names {}) == arg_names::count;
+                constexpr bool unique
+                    = unique_names<names_t<>, ArgNames...>::type::count == arg_names::count;
+
+                static_assert(accepted,
+                    "The function does not take this name, and has no nickel::rest parameter");
+                static_assert(unset, "This name already has an argument");
+                static_assert(unique, "This name is given more than one argument");
+
+                return NICKEL_MOVE(*this).template bind_all_<ArgNames...>(
+                    std::integral_constant<bool, accepted && unset && unique> {},
+                    NICKEL_MOVE(args.value)...);
+            }
+
+            // Call the function with bound arguments
+            constexpr decltype(auto) operator()() &&
+            {
+                // Checked before instantiating the call, so that a missing argument is one error.
+                using all_names = typename Kwargs::template append_names<Names>;
+                return NICKEL_MOVE(*this).call_(std::integral_constant<std::size_t,
+                    detail::first_unbound<Storage, Defaults>(all_names {})> {});
+            }
+
+            // Copies the bound arguments into `arena` so that the call can be finished later.
+            // NOT PUBLIC API
+            template <typename Arena>
+            auto _materialize(priv_tag, Arena& arena) &&
+            {
+                static_assert(!Names::template contains<rest_name>,
+                    "nickel::materialize(...) does not support nickel::rest");
+
+                // Checked here rather than at the later call, so that a missing argument is one
+                // error at the nickel::materialize(...).
+                using all_names = typename Kwargs::template append_names<Names>;
+                return NICKEL_MOVE(*this).materialize_(std::integral_constant<std::size_t,
+                    detail::first_unbound<Storage, Defaults>(all_names {})> {}, arena);
+            }
+
+            // Replaces the wrapped function with `map(fn)`, e.g. to wrap it in nickel::memoize(...).
+            // NOT PUBLIC API
+            template <typename Map>
+            constexpr auto _map_fn(priv_tag, Map&& map) &&
+            {
+                using NewFn = remove_cvref_t<decltype(NICKEL_FWD(map)(NICKEL_MOVE(fn_)))>;
+                return wrapped_fn<Defaults, Storage, NewFn, Kwargs, Names, CallEvalPolicy> {
+                    NICKEL_MOVE(defaults_),
+                    NICKEL_MOVE(storage_),
+                    NICKEL_FWD(map)(NICKEL_MOVE(fn_)),
+                };
+            }
+
+            // Copies this call, but with `map(fn)` as the wrapped function, given our function as an
+            // lvalue, e.g. to refer to it rather than copy it (see nickel::for_each_row).
+            // NOT PUBLIC API
+            template <typename Map>
+            constexpr auto _map_fn(priv_tag, Map&& map) &
+            {
+                using NewFn = remove_cvref_t<decltype(NICKEL_FWD(map)(fn_))>;
+                return wrapped_fn<Defaults, Storage, NewFn, Kwargs, Names, CallEvalPolicy> {
+                    Defaults {defaults_},
+                    Storage {storage_},
+                    NICKEL_FWD(map)(fn_),
+                };
+            }
+
+        private:
+            template <typename... ArgNames, typename... Values>
+            constexpr auto bind_all_(std::true_type, Values&&... values) &&
+            {
+                using NewStorage = decltype(NICKEL_MOVE(storage_).set_all(
+                    names_t<ArgNames...> {}, NICKEL_FWD(values)...));
+                return wrapped_fn<Defaults, NewStorage, remove_cvref_t<Fn>, Kwargs, Names,
+                    CallEvalPolicy> {
+                    NICKEL_MOVE(defaults_),
+                    NICKEL_MOVE(storage_).set_all(names_t<ArgNames...> {}, NICKEL_FWD(values)...),
+                    NICKEL_MOVE(fn_),
+                };
+            }
+
+            // Already reported by a static_assert.
+            template <typename... ArgNames, typename... Values>
+            constexpr invalid_call bind_all_(std::false_type, Values&&...) &&
+            {
+                return {};
+            }
+
+            // None of the kwargs' names are already bound.
+            template <typename OtherStorage>
+            constexpr auto bind_kwargs_(kwargs<OtherStorage>&& kwargs, std::true_type) &&
+            {
+                using NewStorage = decltype(NICKEL_MOVE(kwargs).combine(NICKEL_MOVE(storage_)));
+                return wrapped_fn<Defaults, NewStorage, remove_cvref_t<Fn>, Kwargs, Names,
+                    CallEvalPolicy> {
+                    NICKEL_MOVE(defaults_),
+                    NICKEL_MOVE(kwargs).combine(NICKEL_MOVE(storage_)),
+                    NICKEL_MOVE(fn_),
+                };
+            }
+
+            // One of the kwargs' names is already bound.
+            template <typename OtherStorage>
+            constexpr invalid_call bind_kwargs_(kwargs<OtherStorage>&&, std::false_type) &&
+            {
+                using other_names = typename OtherStorage::bound_names;
+                using name = typename other_names::template at<detail::first_bound<Storage>(
+                    other_names {})>;
+                return (void)duplicate_argument<name> {}, invalid_call {};
+            }
+
+            // Every name has a value.
+            constexpr decltype(auto) call_(
+                std::integral_constant<std::size_t, Kwargs::count + Names::count>) &&
+            {
+                return NICKEL_MOVE(*this).eval_(
+                    std::integral_constant<bool, Names::template contains<rest_name>> {});
+            }
+
+            // The arguments are put in canonical order first, so that the call is instantiated once
+            // for every order in which the same arguments could be set.
+            constexpr decltype(auto) eval_(std::false_type /* has rest */) &&
+            {
+                using order = typename Kwargs::template append_names<Names>;
+                return CallEvalPolicy::eval(NICKEL_MOVE(defaults_),
+                    NICKEL_MOVE(storage_)._canonical(priv_tag {}, tag_t<order> {}), Kwargs {},
+                    Names {}, NICKEL_MOVE(fn_));
+            }
+
+            // Gathers the arguments for names we don't declare into the nickel::rest parameter.
+            constexpr decltype(auto) eval_(std::true_type /* has rest */) &&
+            {
+                using order = typename Kwargs::template append_names<Names>;
+                using split = split_rest<order, Storage>;
+                return CallEvalPolicy::eval(NICKEL_MOVE(defaults_),
+                    NICKEL_MOVE(storage_)
+                        ._split_rest(priv_tag {}, tag_t<rest_name> {},
+                            tag_t<typename split::declared> {}, tag_t<typename split::rest> {})
+                        ._canonical(priv_tag {}, tag_t<order> {}),
+                    Kwargs {}, Names {}, NICKEL_MOVE(fn_));
+            }
+
+            // The name at position I (of the Kwargs then the Names) has no value.
+            template <std::size_t I>
+            constexpr invalid_call call_(std::integral_constant<std::size_t, I>) &&
+            {
+                using name = typename Kwargs::template append_names<Names>::template at<I>;
+                return (void)missing_argument<name> {}, invalid_call {};
+            }
+
+            // Every name has a value.
+            template <typename Arena>
+            auto materialize_(
+                std::integral_constant<std::size_t, Kwargs::count + Names::count>, Arena& arena) &&
+            {
+                using params_t = param_types<typename fn_signature<Fn>::params, Kwargs, Names>;
+                return NICKEL_MOVE(*this).copy_into_(
+                    std::integral_constant<bool,
+                        Storage::template _materializable<params_t>(priv_tag {})> {},
+                    tag_t<params_t> {}, arena);
+            }
+
+            // The name at position I (of the Kwargs then the Names) has no value.
+            template <std::size_t I, typename Arena>
+            invalid_call materialize_(std::integral_constant<std::size_t, I>, Arena&) &&
+            {
+                using name = typename Kwargs::template append_names<Names>::template at<I>;
+                return (void)missing_argument<name> {}, invalid_call {};
+            }
+
+            // Every bound value can be kept.
+            template <typename Params, typename Arena>
+            auto copy_into_(std::true_type, tag_t<Params>, Arena& arena) &&
+            {
+                using NewStorage = decltype(
+                    NICKEL_MOVE(storage_)._materialize(priv_tag {}, tag_t<Params> {}, arena));
+                return materialized_fn<Defaults, NewStorage, Fn, Kwargs, Names, CallEvalPolicy> {
+                    NICKEL_MOVE(defaults_),
+                    NICKEL_MOVE(storage_)._materialize(priv_tag {}, tag_t<Params> {}, arena),
+                    NICKEL_MOVE(fn_),
+                };
+            }
+
+            // A nickel::in_place(...) argument whose parameter type is not known.
+            template <typename Params, typename Arena>
+            invalid_call copy_into_(std::false_type, tag_t<Params>, Arena&) &&
+            {
+                return (void)unknown_in_place_param<Fn> {}, invalid_call {};
+            }
+        };
+
+        // A wrapped_fn whose bound arguments have been copied into an arena.
+        // Unlike wrapped_fn, this owns its arguments, so it may be stored and called later.
+        template <typename Defaults, typename Storage, typename Fn, typename Kwargs, typename Names,
+            typename CallEvalPolicy>
+        class materialized_fn
+        {
+        private:
+            Defaults defaults_;
+            Storage storage_;
+            Fn fn_;
+            // Whether we are responsible for destroying the arguments in the arena.
+            bool owner_ = true;
+
+        public:
+            template <typename FDefaults, typename FFn>
+            explicit materialized_fn(FDefaults&& defaults, Storage&& storage, FFn&& fn)
+                : defaults_ {NICKEL_FWD(defaults)}
+                , storage_ {NICKEL_MOVE(storage)}
+                , fn_ {NICKEL_FWD(fn)}
+            { }
+
+            materialized_fn(materialized_fn&& other)
+                : defaults_ {NICKEL_MOVE(other.defaults_)}
+                , storage_ {NICKEL_MOVE(other.storage_)}
+                , fn_ {NICKEL_MOVE(other.fn_)}
+                , owner_ {other.owner_}
+            {
+                other.owner_ = false;
+            }
+
+            materialized_fn& operator=(materialized_fn&&) = delete;
+
+            ~materialized_fn()
+            {
+                if (owner_) storage_._destroy(priv_tag {});
+            }
+
+            // Call the function with the materialized arguments.
+            // The arguments are passed as rvalues; they are destroyed along with *this.
+            decltype(auto) operator()() &&
+            {
+                return CallEvalPolicy::eval(NICKEL_MOVE(defaults_), NICKEL_MOVE(storage_),
+                    Kwargs {}, Names {}, NICKEL_MOVE(fn_));
+            }
+        };
+
+        // The default policy: calls the function with the named arguments
+        struct named_eval_policy
+        {
+            // Calls the function, including kwargs parameters.
+            template <typename Defaults, typename Storage, typename Kwargs, typename Names,
+                typename Fn>
+            static constexpr decltype(auto) eval_impl(
+                std::true_type, Defaults&& defaults, Storage&& storage, Kwargs, Names, Fn&& fn)
+            {
+                return Names::map_reduce(NICKEL_FWD(fn), NICKEL_FWD(storage), NICKEL_FWD(defaults),
+                    NICKEL_FWD(storage).get(detail::tag_t<Kwargs> {}, NICKEL_FWD(defaults)));
+            }
+
+            // Calls the function, in the absence of kwargs.
+            template <typename Defaults, typename Storage, typename Kwargs, typename Names,
+                typename Fn>
+            static constexpr decltype(auto) eval_impl(
+                std::false_type, Defaults&& defaults, Storage&& storage, Kwargs, Names, Fn&& fn)
+            {
+                return Names::map_reduce(
+                    NICKEL_MOVE(fn), NICKEL_MOVE(storage), NICKEL_MOVE(defaults));
+            }
+
+            // Evaluate the function call
+            template <typename Defaults, typename Storage, typename Kwargs, typename Names,
+                typename Fn>
+            static constexpr decltype(auto) eval(
+                Defaults&& defaults, Storage&& storage, Kwargs, Names, Fn&& fn)
+            {
+                return eval_impl(std::integral_constant<bool, Kwargs::count != 0> {},
+                    NICKEL_FWD(defaults), NICKEL_FWD(storage), Kwargs {}, Names {}, NICKEL_FWD(fn));
+            }
+        };
+
+        // What nickel::overload(...) needs to know about each of its functions.
+        template <typename WrappedFn>
+        struct overload_traits
+        {
+            static constexpr bool is_wrapped_fn = false;
+            using names = names_t<>;
+        };
+
+        template <typename Defaults, typename Fn, typename Kwargs, typename Names,
+            typename CallEvalPolicy>
+        struct overload_traits<wrapped_fn<Defaults, storage<>, Fn, Kwargs, Names, CallEvalPolicy>>
+        {
+            static constexpr bool is_wrapped_fn = true;
+            using defaults = Defaults;
+            using names = typename Kwargs::template append_names<Names>;
+        };
+
+        template <typename... WrappedFns>
+        constexpr bool all_overloadable()
+        {
+            constexpr bool overloadable[] = {true, overload_traits<WrappedFns>::is_wrapped_fn...};
+            for (bool is_wrapped_fn : overloadable) {
+                if (!is_wrapped_fn) return false;
+            }
+            return true;
+        }
+
+        // Every name of every one of the names_t<...> Lists, once each.
+        template <typename Unique, typename... Lists>
+        struct union_names
+        {
+            using type = Unique;
+        };
+
+        template <typename Unique, typename... Names, typename... Lists>
+        struct union_names<Unique, names_t<Names...>, Lists...>
+            : union_names<typename unique_names<Unique, Names...>::type, Lists...>
+        { };
+
+        // Are these two arities (see `.multivalued<N>()`) of the same name?
+        template <typename Name, typename Other>
+        struct other_arity : std::false_type
+        { };
+
+        template <template <int> class Name, int N, int M>
+        struct other_arity<Name<N>, Name<M>> : std::integral_constant<bool, N != M>
+        { };
+
+        template <typename Name, typename... Names>
+        constexpr bool has_other_arity()
+        {
+            constexpr bool other[] = {false, other_arity<Name, Names>::value...};
+            for (bool is_other : other) {
+                if (is_other) return true;
+            }
+            return false;
+        }
+
+        // Each arity of a name has its own setter, so two of them would make the setter ambiguous.
+        template <typename... Names>
+        constexpr bool one_arity_per_name(names_t<Names...>)
+        {
+            constexpr bool conflicts[] = {false, has_other_arity<Names, Names...>()...};
+            for (bool conflict : conflicts) {
+                if (conflict) return false;
             }
+            return true;
+        }
 
-            template <typename Name, typename Defaults>
-            constexpr decltype(auto) get_or_default_(std::true_type, tag_t<Name> id, Defaults&&) &&
-            {
-                return NICKEL_MOVE(*this).get(id);
+        // Can an overload with these Names and Defaults be called with the arguments in Storage?
+        // It must take every bound name, and every one of its names must have a value.
+        template <typename Storage, typename Defaults, typename Names, typename... Bound>
+        constexpr bool overload_viable(names_t<Bound...>)
+        {
+            constexpr bool taken[] = {true, Names::template contains<Bound>...};
+            for (bool is_taken : taken) {
+                if (!is_taken) return false;
             }
+            return detail::first_unbound<Storage, Defaults>(Names {}) == Names::count;
+        }
 
-            // Retrieves the bound value associated with the Name, else falls back on retrieving
-            // from `defaults`.
-            template <typename Name, typename Defaults>
-            constexpr decltype(auto) get_or_default(tag_t<Name> id, Defaults&& defaults) &&
-            {
-                return NICKEL_MOVE(*this).get_or_default_(
-                    std::integral_constant<bool, is_set<Name>> {}, id, NICKEL_FWD(defaults));
+        // The position of the only viable overload; `sizeof...(Traits)` if there is none, or
+        // `sizeof...(Traits) + 1` if there are several.
+        template <typename Storage, typename... Traits>
+        constexpr std::size_t select_overload()
+        {
+            constexpr bool viable[] = {false,
+                detail::overload_viable<Storage, typename Traits::defaults, typename Traits::names>(
+                    typename Storage::bound_names {})...};
+
+            std::size_t selected = sizeof...(Traits);
+            for (std::size_t index = 0; index != sizeof...(Traits); ++index) {
+                if (!viable[index + 1]) continue;
+                if (selected != sizeof...(Traits)) return sizeof...(Traits) + 1;
+                selected = index;
             }
-#endif
+            return selected;
+        }
 
-            // NOT PUBLIC API
-            // TODO: figure out how to enforce non-public API.
-            // TODO: figure out precisely what this does.
-            template <typename... Names, typename Defaults>
-            constexpr decltype(auto) get(tag_t<names_t<Names...>>, Defaults&& defaults) &&
-            {
-                using kwargs_storage_t = storage<lookup_name<Names>...>;
-                return kwargs<kwargs_storage_t> {
-                    construct_tag {},
-                    kwargs_storage_t {
-                        construct_tag {},
-                        NICKEL_MOVE(*this).get_or_default(tag_t<Names> {}, NICKEL_FWD(defaults))...,
-                    },
-                };
-            }
+        // Reports an overloaded call which cannot be made. BoundNames are the names which were set.
+        template <typename BoundNames>
+        struct no_viable_overload
+        {
+            static_assert(sizeof(BoundNames) == 0,
+                "No overload can be called with the names which were set");
         };
 
-        // Provide the .<name>() member iff the parameter hasn't been set before.
-        template <typename Storage, typename Name, typename CRTP>
-        using allow_set_only_if_unset = conditional_t<Storage::template is_set<Name>, tag_t<Name>,
-            typename Name::template set_type<CRTP>>;
-
-        // Unwraps the names_t<...> Kwargs and Names parameters of the wrapped_fn.
-        template <typename Derived, typename Storage, typename Kwargs, typename Names>
-        struct wrapped_fn_base;
-
-        template <typename Derived, typename Storage, typename... Kwargs, typename... Names>
-        struct wrapped_fn_base<Derived, Storage, names_t<Kwargs...>, names_t<Names...>>
-            : // Provide .<name>() members for kwargs.
-              public allow_set_only_if_unset<Storage, Kwargs, Derived>...,
-              // Provide .<name>() members for named parameters.
-              public allow_set_only_if_unset<Storage, Names, Derived>...
-        { };
+        template <typename BoundNames>
+        struct ambiguous_overload
+        {
+            static_assert(sizeof(BoundNames) == 0,
+                "Ambiguous call: more than one overload can be called with the names which were "
+                "set");
+        };
 
-        // wrapped_fn is the main workhorse of Nickel.
+        // The in-progress call of a nickel::overload(...): collects the arguments for any of the
+        // overloads' names, then passes them as kwargs to the one overload which can take them.
+        template <typename Storage, typename Names, typename... Fns>
+        class overload_fn;
 
-        // The in-progress function call sequence.
-        template <typename Defaults, // The default arguments
-            typename Storage, // Any currently bound arguments
-            typename Fn, // The actual function we are wrapping (which we will call)
-            typename Kwargs, // Any Kwargs
-            typename Names, // The explicit named parameters
-            typename CallEvalPolicy> // How to implement calling `Fn`.
-        class wrapped_fn : public wrapped_fn_base<
-                               wrapped_fn<Defaults, Storage, Fn, Kwargs, Names, CallEvalPolicy>,
-                               Storage, Kwargs, Names>
+        template <typename Storage, typename... Names, typename... Fns>
+        class overload_fn<Storage, names_t<Names...>, Fns...>
+            : public allow_set_only_if_unset<Storage, Names,
+                  overload_fn<Storage, names_t<Names...>, Fns...>>...
         {
         private:
-            Defaults defaults_;
+            std::tuple<Fns...> fns_;
             Storage storage_;
-            Fn fn_;
 
         public:
-            template <typename FDefaults, typename FFn>
-            explicit constexpr wrapped_fn(FDefaults&& defaults, Storage&& storage, FFn&& fn)
-                : defaults_ {NICKEL_FWD(defaults)}
+            explicit constexpr overload_fn(std::tuple<Fns...>&& fns, Storage&& storage)
+                : fns_ {NICKEL_MOVE(fns)}
                 , storage_ {NICKEL_MOVE(storage)}
-                , fn_ {NICKEL_FWD(fn)}
             { }
 
             // Bind the name to the multi-valued argument.
             // NOT PUBLIC API
-            // TODO: figure out how to enforce the NOT PUBLIC API
             template <typename Name, int N, typename... Ts>
-            constexpr auto operator()(set_tag, Name, int_t<N>, Ts&&... values) &&
+            NICKEL_DETAIL_INLINE constexpr auto operator()(
+                set_tag, Name, int_t<N>, Ts&&... values) &&
             {
                 using NewStorage = decltype(NICKEL_MOVE(storage_).template _set_value<Name>(
-                    set_tag {}, std::tuple<Ts&&...>(NICKEL_FWD(values)...)));
-                return wrapped_fn<Defaults, NewStorage, remove_cvref_t<Fn>, Kwargs, Names,
-                    CallEvalPolicy> {
-                    NICKEL_MOVE(defaults_),
+                    set_tag {}, multivalue(int_t<N> {}, NICKEL_FWD(values)...)));
+                return overload_fn<NewStorage, names_t<Names...>, Fns...> {
+                    NICKEL_MOVE(fns_),
                     NICKEL_MOVE(storage_).template _set_value<Name>(
-                        set_tag {}, std::tuple<Ts&&...>(NICKEL_FWD(values)...)),
-                    NICKEL_MOVE(fn_),
+                        set_tag {}, multivalue(int_t<N> {}, NICKEL_FWD(values)...)),
                 };
             }
 
             // Bind the name to the single argument.
             // NOT PUBLIC API
-            // TODO: figure out how to enforce the NOT PUBLIC API
             template <typename Name, typename T>
-            constexpr auto operator()(set_tag, Name, int_t<-1>, T&& value) &&
+            NICKEL_DETAIL_INLINE constexpr auto operator()(set_tag, Name, int_t<-1>, T&& value) &&
             {
                 using NewStorage
                     = decltype(NICKEL_MOVE(storage_).template set<Name>(NICKEL_FWD(value)));
-                return wrapped_fn<Defaults, NewStorage, remove_cvref_t<Fn>, Kwargs, Names,
-                    CallEvalPolicy> {
-                    NICKEL_MOVE(defaults_),
+                return overload_fn<NewStorage, names_t<Names...>, Fns...> {
+                    NICKEL_MOVE(fns_),
                     NICKEL_MOVE(storage_).template set<Name>(NICKEL_FWD(value)),
-                    NICKEL_MOVE(fn_),
                 };
             }
 
-            // Bind the kwargs
-            // NOT PUBLIC API
-            // TODO: figure out how to enforce the NOT PUBLIC API
-            template <typename OtherStorage>
-            constexpr auto operator()(kwargs<OtherStorage>&& kwargs) &&
+            // Call the overload which can take the bound arguments
+            constexpr decltype(auto) operator()() &&
             {
-                using NewStorage = decltype(NICKEL_MOVE(kwargs).combine(NICKEL_MOVE(storage_)));
-                return wrapped_fn<Defaults, NewStorage, remove_cvref_t<Fn>, Kwargs, Names,
-                    CallEvalPolicy> {
-                    NICKEL_MOVE(defaults_),
-                    NICKEL_MOVE(kwargs).combine(NICKEL_MOVE(storage_)),
-                    NICKEL_MOVE(fn_),
-                };
+                return NICKEL_MOVE(*this).call_(std::integral_constant<std::size_t,
+                    detail::select_overload<Storage, overload_traits<Fns>...>()> {});
             }
 
-            // Call the function with bound arguments
-            constexpr decltype(auto) operator()() &&
+        private:
+            template <std::size_t I>
+            constexpr decltype(auto) call_(std::integral_constant<std::size_t, I>) &&
             {
-                return CallEvalPolicy::eval(NICKEL_MOVE(defaults_), NICKEL_MOVE(storage_),
-                    Kwargs {}, Names {}, NICKEL_MOVE(fn_));
+                return std::get<I>(NICKEL_MOVE(fns_))(
+                    kwargs<Storage> {construct_tag {}, NICKEL_MOVE(storage_)})();
+            }
+
+            constexpr invalid_call call_(std::integral_constant<std::size_t, sizeof...(Fns)>) &&
+            {
+                return (void)no_viable_overload<typename Storage::bound_names> {}, invalid_call {};
+            }
+
+            constexpr invalid_call call_(
+                std::integral_constant<std::size_t, sizeof...(Fns) + 1>) &&
+            {
+                return (void)ambiguous_overload<typename Storage::bound_names> {}, invalid_call {};
             }
         };
 
-        // The default policy: calls the function with the named arguments
-        struct named_eval_policy
+        // A single stolen member also converts to the member itself, so that
+        // `T member = std::move(object).steal().member()();` needs no tuple.
+        template <typename Derived, typename... Ts>
+        struct stolen_conversion
+        { };
+
+        template <typename Derived, typename T>
+        struct stolen_conversion<Derived, T>
         {
-            // Calls the function, including kwargs parameters.
-            template <typename Defaults, typename Storage, typename Kwargs, typename Names,
-                typename Fn>
-            static constexpr decltype(auto) eval_impl(
-                std::true_type, Defaults&& defaults, Storage&& storage, Kwargs, Names, Fn&& fn)
+            constexpr operator T() &&
             {
-                return Names::map_reduce(NICKEL_FWD(fn), NICKEL_FWD(storage), NICKEL_FWD(defaults),
-                    NICKEL_FWD(storage).get(detail::tag_t<Kwargs> {}, NICKEL_FWD(defaults)));
+                return std::get<0>(static_cast<std::tuple<T>&&>(static_cast<Derived&&>(*this)));
             }
+        };
 
-            // Calls the function, in the absence of kwargs.
-            template <typename Defaults, typename Storage, typename Kwargs, typename Names,
-                typename Fn>
-            static constexpr decltype(auto) eval_impl(
-                std::false_type, Defaults&& defaults, Storage&& storage, Kwargs, Names, Fn&& fn)
+        // The result of stealing members: holds the stolen members in the order the caller
+        // requested them. Each member is moved exactly once, directly into its place in the result.
+        // Stolen members are accessible by name (`.<name>()`), by structured bindings, or via
+        // std::get. The members which were not stolen stay in the original object; their `.<name>()`
+        // accessors give read-only access to them there, so they must not be used once the original
+        // object is destroyed.
+        template <typename Class, typename Members, typename Names, typename Selected,
+            typename... Ts>
+        class stolen;
+
+        template <typename Class, typename Members, typename... Names, typename... Selected,
+            typename... Ts>
+        class stolen<Class, Members, names_t<Names...>, names_t<Selected...>, Ts...>
+            : public std::tuple<Ts...>,
+              public stolen_conversion<
+                  stolen<Class, Members, names_t<Names...>, names_t<Selected...>, Ts...>, Ts...>,
+              public Names::template get_type<
+                  stolen<Class, Members, names_t<Names...>, names_t<Selected...>, Ts...>>...
+        {
+            using tuple_type = std::tuple<Ts...>;
+
+            template <typename Name>
+            using is_stolen
+                = std::integral_constant<bool, names_t<Selected...>::template contains<Name>>;
+
+            Members members_;
+            Class const* object_;
+
+            template <typename Tuple, typename Name>
+            static constexpr decltype(auto) get_member(
+                std::true_type, Tuple&& stolen_members, Class const*, Members const&, tag_t<Name>)
             {
-                return Names::map_reduce(
-                    NICKEL_MOVE(fn), NICKEL_MOVE(storage), NICKEL_MOVE(defaults));
+                return std::get<names_t<Selected...>::template index_of<Name>()>(
+                    NICKEL_FWD(stolen_members));
             }
 
-            // Evaluate the function call
-            template <typename Defaults, typename Storage, typename Kwargs, typename Names,
-                typename Fn>
-            static constexpr decltype(auto) eval(
-                Defaults&& defaults, Storage&& storage, Kwargs, Names, Fn&& fn)
+            // Not stolen: read it from the original object.
+            template <typename Tuple, typename Name>
+            static constexpr decltype(auto) get_member(std::false_type, Tuple&&,
+                Class const* object, Members const& members, tag_t<Name> id)
             {
-                return eval_impl(std::integral_constant<bool, Kwargs::count != 0> {},
-                    NICKEL_FWD(defaults), NICKEL_FWD(storage), Kwargs {}, Names {}, NICKEL_FWD(fn));
+                return object->*(members.get(id));
+            }
+
+        public:
+            template <typename... StolenMembers>
+            explicit constexpr stolen(construct_tag, Members const& members, Class const* object,
+                StolenMembers&&... stolen_members)
+                : tuple_type(NICKEL_FWD(stolen_members)...)
+                , members_ {members}
+                , object_ {object}
+            { }
+
+            // NOT PUBLIC API
+            // Retrieves the member for `Name`; implements the `.<name>()` accessors.
+            template <typename Name>
+            constexpr decltype(auto) operator()(get_tag, Name) &
+            {
+                return get_member(is_stolen<Name> {}, static_cast<tuple_type&>(*this), object_,
+                    members_, tag_t<Name> {});
+            }
+
+            template <typename Name>
+            constexpr decltype(auto) operator()(get_tag, Name) const&
+            {
+                return get_member(is_stolen<Name> {}, static_cast<tuple_type const&>(*this),
+                    object_, members_, tag_t<Name> {});
+            }
+
+            template <typename Name>
+            constexpr decltype(auto) operator()(get_tag, Name) &&
+            {
+                return get_member(is_stolen<Name> {}, static_cast<tuple_type&&>(*this), object_,
+                    members_, tag_t<Name> {});
+            }
+
+            template <typename Name>
+            constexpr decltype(auto) operator()(get_tag, Name) const&&
+            {
+                return get_member(is_stolen<Name> {}, static_cast<tuple_type const&&>(*this),
+                    object_, members_, tag_t<Name> {});
             }
         };
 
-        // Re-uses the wrapped_fn workhorse to implement member stealing.
-        struct steal_eval_policy
+        // The type of the data member which `PtrToMemData` points to.
+        template <typename PtrToMemData>
+        struct member_type;
+
+        template <typename Class, typename Member>
+        struct member_type<Member Class::*>
+        {
+            using type = Member;
+        };
+
+        // Provide the .<name>() member iff the member hasn't been stolen already.
+        template <typename Derived, typename Selected, typename Names>
+        struct steal_fn_base;
+
+        template <typename Derived, typename Selected, typename... Names>
+        struct steal_fn_base<Derived, Selected, names_t<Names...>>
+            : public conditional_t<Selected::template contains<Names>, tag_t<Names>,
+                  typename Names::template set_type<Derived>>...
+        { };
+
+        // The in-progress member stealing sequence.
+        template <typename Class, // The class we are stealing from
+            typename Members, // A storage<...> mapping each name to its pointer-to-member-data
+            typename Names, // The names of all the members which may be stolen
+            typename Selected> // The names of the members requested so far, in order
+        class steal_fn : public steal_fn_base<steal_fn<Class, Members, Names, Selected>, Selected, Names>
         {
-            // Defaults -> the members of the class we are stealing from
-            // Storage -> 0-arg values, storing the members requested and their order
-            // Fn -> The object which we are stealing from
+        private:
+            Members members_;
+            Class* object_;
+
+            template <typename Name>
+            constexpr decltype(auto) steal_member(tag_t<Name> id)
+            {
+                return NICKEL_MOVE(object_->*(NICKEL_MOVE(members_).get(id)));
+            }
+
+            template <typename Name>
+            using member_t = typename member_type<remove_cvref_t<decltype(
+                std::declval<Members&&>().get(tag_t<Name> {}))>>::type;
+
+            template <typename... Names_>
+            constexpr auto finish(names_t<Names_...>)
+            {
+                return stolen<Class, Members, Names, Selected, member_t<Names_>...> {
+                    construct_tag {},
+                    members_,
+                    object_,
+                    steal_member(tag_t<Names_> {})...,
+                };
+            }
+
+        public:
+            explicit constexpr steal_fn(construct_tag, Members&& members, Class* object)
+                : members_ {NICKEL_MOVE(members)}
+                , object_ {object}
+            { }
 
-            // Normally: Defaults, Storage, Kwargs, Names, Fn.
-            // We're re-using those for something else
-            template <typename Members, typename Names_, typename Class, typename... Names>
-            static constexpr auto eval(Members&& members,
-                storage<named<Names, std::tuple<>>...> /* storage */, names_t<> /* kwargs */,
-                Names_ /* names */, Class* object)
+            // Request the member corresponding to `Name`.
+            // NOT PUBLIC API
+            template <typename Name>
+            constexpr auto operator()(set_tag, Name, int_t<0>) &&
             {
-                return std::make_tuple(
-                    NICKEL_MOVE(object->*(NICKEL_MOVE(members).get(tag_t<Names> {})))...);
+                return steal_fn<Class, Members, Names, typename Selected::template append<Name>> {
+                    construct_tag {},
+                    NICKEL_MOVE(members_),
+                    object_,
+                };
             }
 
-            // Special case the single-name version to remove the tuple
-            template <typename Members, typename Names_, typename Class, typename Name>
-            static constexpr decltype(auto) eval(Members&& members,
-                storage<named<Name, std::tuple<>>> /* storage */, names_t<> /* kwargs */,
-                Names_ /* names */, Class* object)
+            // Steal the requested members
+            constexpr auto operator()() &&
             {
-                return NICKEL_MOVE(object->*(NICKEL_MOVE(members).get(tag_t<Name> {})));
+                return finish(Selected {});
             }
         };
 
+        // How a wrapped function stores its callable.
+        // Captureless, non-generic lambdas (and functions) are stored as function pointers. This
+        // way, every function with the same names, defaults, and signature builds its arguments
+        // through the same wrapped_fn types, rather than instantiating a fresh setter chain each.
+        template <typename Fn, typename = void>
+        struct stored_fn
+        {
+            using type = Fn;
+        };
+
+        template <typename Fn>
+        struct stored_fn<Fn,
+            std::enable_if_t<std::is_pointer<decltype(+std::declval<Fn const&>())>::value
+                && std::is_function<
+                    std::remove_pointer_t<decltype(+std::declval<Fn const&>())>>::value>>
+        {
+            using type = decltype(+std::declval<Fn const&>());
+        };
+
+        template <typename Fn>
+        using stored_fn_t = typename stored_fn<Fn>::type;
+
         // A partial function definition where the names have been specified, but not the function.
         // i.e. nickel::wrap(name1, name2), but without the second parentheses.
-        template <typename Defaults, typename Kwargs, typename Names>
+        // `Thin`: builds a thin_fn rather than a wrapped_fn; see <nickel/thin.hpp>.
+        template <typename Defaults, typename Kwargs, typename Names, bool Thin = false>
         class partial_wrap : private Defaults
         {
         public:
             template <typename FDefaults>
-            explicit constexpr partial_wrap(construct_tag, FDefaults&& defaults)
+            NICKEL_DETAIL_INLINE explicit constexpr partial_wrap(
+                construct_tag, FDefaults&& defaults)
                 : Defaults {NICKEL_FWD(defaults)}
             { }
 
@@ -580,7 +2549,7 @@ namespace nickel {
             template <typename Fn>
             constexpr auto operator()(Fn&& fn) &&
             {
-                using DFn = remove_cvref_t<Fn>;
+                using DFn = stored_fn_t<remove_cvref_t<Fn>>;
 
                 return wrapped_fn<Defaults, storage<>, DFn, Kwargs, Names, named_eval_policy> {
                     Defaults {static_cast<Defaults&&>(*this)},
@@ -607,6 +2576,10 @@ namespace nickel {
         struct mark_kwargs_tag
         { };
 
+        // Selects thin mode in `name_group_to_partial_fn_tag`.
+        struct thin_tag
+        { };
+
         // Groups several names into one piece of functionality that can be passed like one name.
         // Every path through `nickel::wrap(...)` or similar gets wrapped in a name_group to enable
         // uniformity in name_group's abilities.
@@ -615,13 +2588,14 @@ namespace nickel {
         {
         public:
             template <typename FDefaults>
-            explicit constexpr name_group(construct_tag, FDefaults&& defaults)
+            NICKEL_DETAIL_INLINE explicit constexpr name_group(construct_tag, FDefaults&& defaults)
                 : Defaults {NICKEL_FWD(defaults)}
             { }
 
             // Produces a single name_group which has all of _our_ names and all of _group_'s names.
             template <typename OtherDefaults, typename OtherKwargs, typename OtherNames>
-            constexpr auto combine(name_group<OtherDefaults, OtherKwargs, OtherNames>&& group) &&
+            NICKEL_DETAIL_INLINE constexpr auto combine(
+                name_group<OtherDefaults, OtherKwargs, OtherNames>&& group) &&
             {
                 using combined_defaults = remove_cvref_t<decltype(
                     static_cast<Defaults&&>(*this).combine((OtherDefaults &&) group))>;
@@ -643,15 +2617,12 @@ namespace nickel {
                 };
             }
 
-            // Initiates the member stealing sequence.
-            template <typename Class>
-            constexpr auto _make_steal_wrapped_fn(priv_tag, Class* obj) &&
+            // Initiates the partial_wrap sequence for a thin_fn.
+            constexpr auto operator()(name_group_to_partial_fn_tag, thin_tag) &&
             {
-                return detail::wrapped_fn<Defaults, storage<>, Class*, names_t<>, Names,
-                    steal_eval_policy> {
+                return detail::partial_wrap<Defaults, Kwargs, Names, true> {
+                    construct_tag {},
                     static_cast<Defaults&&>(*this),
-                    storage<> {construct_tag {}},
-                    obj,
                 };
             }
 
@@ -664,17 +2635,11 @@ namespace nickel {
                     static_cast<Defaults&&>(*this),
                 };
             }
-
-            // Detects if this name_group has any kwargs.
-            static constexpr bool _has_kwargs(priv_tag)
-            {
-                return !NICKEL_IS_SAME(Kwargs, names_t<>);
-            }
         };
 
         // Wraps a single argument into a name_group.
         template <typename Name>
-        constexpr auto name_group_single(Name&&)
+        NICKEL_DETAIL_INLINE constexpr auto name_group_single(Name&&)
         {
             return detail::name_group<detail::storage<>, detail::names_t<>,
                 detail::names_t<typename detail::remove_cvref_t<Name>::name_type>> {
@@ -685,7 +2650,7 @@ namespace nickel {
 
         // Wraps a single defaulted argument into a name_group.
         template <typename Name, typename Value>
-        constexpr auto name_group_single(defaulted<Name, Value> defaulted_arg)
+        NICKEL_DETAIL_INLINE constexpr auto name_group_single(defaulted<Name, Value> defaulted_arg)
         {
             return name_group<storage<named<Name, Value>>, names_t<>,
                 names_t<typename remove_cvref_t<Name>::name_type>> {
@@ -699,12 +2664,15 @@ namespace nickel {
 
         // "Wraps" a single name_group argument into a name_group
         template <typename Defaults, typename Kwargs, typename Names>
-        constexpr auto name_group_single(name_group<Defaults, Kwargs, Names> group)
+        NICKEL_DETAIL_INLINE constexpr auto name_group_single(
+            name_group<Defaults, Kwargs, Names> group)
         {
             return NICKEL_MOVE(group);
         }
 
         // Combines a sequence of name_groups into one.
+        // Not NICKEL_DETAIL_INLINE: inlining the whole recursion into one function emits
+        // O(N^2) code for N defaults, which is slower to compile than the calls it saves.
         constexpr auto name_group_impl()
         {
             return name_group<storage<>, names_t<>, names_t<>> {
@@ -754,6 +2722,49 @@ namespace nickel {
         return nickel::name_group(NICKEL_FWD(names)...)(detail::name_group_to_partial_fn_tag {});
     }
 
+    // EXPERIMENTAL
+    // Combines several nickel-wrapped functions into one. The combined function has the setters of
+    // all of their names; calling it calls the one function which takes exactly the names that were
+    // set (plus any with defaults). The choice is made at compile time; it is an error if no
+    // function, or more than one, can be called.
+    //   auto area = nickel::overload(circle_area(), rectangle_area());
+    //   area().radius(1)();
+    template <typename... WrappedFns>
+    constexpr auto overload(WrappedFns&&... fns)
+    {
+        static_assert(sizeof...(WrappedFns) != 0, "nickel::overload(...) requires a function");
+
+        static_assert(detail::all_overloadable<detail::remove_cvref_t<WrappedFns>...>(),
+            "nickel::overload(...) takes functions made with nickel::wrap(...)(...), with no "
+            "arguments set yet");
+
+        using names_t = typename detail::union_names<detail::names_t<>,
+            typename detail::overload_traits<detail::remove_cvref_t<WrappedFns>>::names...>::type;
+        static_assert(detail::one_arity_per_name(names_t {}),
+            "nickel::overload(...) requires each name to take the same number of values in every "
+            "function");
+
+        return detail::overload_fn<detail::storage<>, names_t,
+            detail::remove_cvref_t<WrappedFns>...> {
+            std::tuple<detail::remove_cvref_t<WrappedFns>...>(NICKEL_FWD(fns)...),
+            detail::storage<> {detail::construct_tag {}},
+        };
+    }
+
+    // EXPERIMENTAL
+    // A parameter which collects the arguments for every name the function doesn't otherwise take.
+    // Such arguments are set with `(name = value, ...)`; the function receives them as kwargs,
+    // which it can forward to another nickel-wrapped function:
+    //   nickel::wrap(x, nickel::rest)([](int x, auto&& rest) { return inner()(NICKEL_FWD(rest))(); })
+    //   ...
+    //   fn().x(1)(y = 2, z = 3)();
+    constexpr detail::defaulted<detail::rest_name, detail::kwargs<detail::storage<>>> rest {
+        detail::kwargs<detail::storage<>> {
+            detail::construct_tag {},
+            detail::storage<> {detail::construct_tag {}},
+        },
+    };
+
     // Marks a default argument value as unevaluated unless needed.
     template <typename Lambda>
     constexpr auto deferred(Lambda&& fn)
@@ -762,22 +2773,164 @@ namespace nickel {
             detail::construct_tag {}, NICKEL_FWD(fn));
     }
 
+    // Marks a default argument value as computed, only if needed, from the arguments for `names`
+    // (their arguments if set, else their defaults), which `fn` receives as lvalues:
+    //   nickel::wrap(width, height = nickel::deferred([](int width) { return width; }, width))
+    // Not supported for kwargs or in thin mode.
+    template <typename Lambda, typename Name, typename... Names>
+    constexpr auto deferred(Lambda&& fn, Name, Names...)
+    {
+        return detail::deferred_from<detail::remove_cvref_t<Lambda>, typename Name::name_type,
+            typename Names::name_type...>(detail::construct_tag {}, NICKEL_FWD(fn));
+    }
+
+#ifdef __cpp_nontype_template_parameter_auto
+    // A compile-time argument, equivalent to `.name<V>()`: the function receives a
+    // std::integral_constant, so it can branch on `V` with `if constexpr`. Like any
+    // std::integral_constant argument, it takes no space in the builder.
+    template <auto V>
+    constexpr std::integral_constant<decltype(V), V> c {};
+#endif
+
+    // The arguments of a `.multivalued()` name: `fn().ids(1, 2, 3)()` calls the function with a
+    // random-access range of `int const&`. The arguments are not copied, and the function receives
+    // the same type however many are passed. `ids.multivalued() = nickel::values<int> {}` defaults
+    // to none.
+    template <typename T>
+    using values = detail::values<T>;
+
+    // Constructs an argument from `args` directly in the function's parameter, rather than moving
+    // in a temporary: `fn().name(nickel::in_place(args...))()`. The arguments are held by
+    // reference, so this is for arguments, not default arguments.
+    template <typename... Args>
+    constexpr auto in_place(Args&&... args)
+    {
+        return detail::in_place_args<Args...>(detail::construct_tag {}, NICKEL_FWD(args)...);
+    }
+
+    // A monotonic buffer over caller-provided memory, for use with nickel::materialize(...).
+    // Memory is never reclaimed; the buffer may be reused once everything placed in it is destroyed.
+    // Any type with a compatible `allocate(size, alignment)` (e.g. a std::pmr::memory_resource)
+    // can be used in its place.
+    class arena
+    {
+    public:
+        constexpr arena(void* buffer, std::size_t size) noexcept
+            : next_ {buffer}
+            , remaining_ {size}
+        { }
+
+        template <std::size_t N>
+        constexpr explicit arena(unsigned char (&buffer)[N]) noexcept
+            : arena(buffer, N)
+        { }
+
+        arena(arena const&) = delete;
+        arena& operator=(arena const&) = delete;
+
+        // Throws std::bad_alloc if the buffer is exhausted.
+        void* allocate(std::size_t size, std::size_t alignment)
+        {
+            void* const result = std::align(alignment, size, next_, remaining_);
+            if (result == nullptr) throw std::bad_alloc {};
+
+            next_ = static_cast<unsigned char*>(next_) + size;
+            remaining_ -= size;
+
+            return result;
+        }
+
+        // The number of bytes left in the buffer, ignoring alignment.
+        constexpr std::size_t remaining() const noexcept
+        {
+            return remaining_;
+        }
+
+    private:
+        void* next_;
+        std::size_t remaining_;
+    };
+
+    // EXPERIMENTAL
+    // Copies the arguments bound so far into `arena`, laid out contiguously, and returns a callable
+    // which owns them. Unlike an in-progress call, the result may be stored and finished later:
+    //   auto call = nickel::materialize(fn().x(a).y(b), arena);
+    //   ...
+    //   std::move(call)();
+    template <typename WrappedFn, typename Arena>
+    auto materialize(WrappedFn&& fn, Arena& arena)
+    {
+        static_assert(!std::is_lvalue_reference<WrappedFn>::value,
+            "nickel::materialize(...) consumes the in-progress call; pass an rvalue");
+
+        return NICKEL_MOVE(fn)._materialize(detail::priv_tag {}, arena);
+    }
+
+    // EXPERIMENTAL
+    // A named view of `object`'s members, declared like nickel::steal(...): `name = &Class::member`.
+    // Each `.<name>()` refers to the member in place; nothing is copied. The view can be passed to a
+    // nickel-wrapped function in place of setting each name:
+    //   fn()(nickel::view(point, x = &Point::x, y = &Point::y))();
+    template <typename Class, typename... Names, typename... PtrToMemData>
+    constexpr auto view(Class&& object, detail::defaulted<Names, PtrToMemData>... names)
+    {
+        static_assert(std::is_lvalue_reference<Class>::value,
+            "nickel::view(...) refers to the object's members; pass an lvalue");
+
+        using storage_t = detail::storage<detail::named<Names,
+            decltype(std::declval<Class&>().*std::declval<PtrToMemData>())>...>;
+
+        return detail::named_view<storage_t, detail::names_t<Names...>> {
+            detail::construct_tag {},
+            storage_t {
+                detail::construct_tag {},
+                detail::named<Names, decltype(std::declval<Class&>().*std::declval<PtrToMemData>())> {
+                    object.*(names.value),
+                }...,
+            },
+        };
+    }
+
     // EXPERIMENTAL
     // Enables stealing members from `object` in the order specified by the caller.
+    // The result owns the stolen members, but reads the others from `object` in place: if `object`
+    // is a temporary, only the stolen members may be used once it is destroyed.
     template <typename Class, typename... Names, typename... PtrToMemData>
     constexpr auto steal(Class&& object, detail::defaulted<Names, PtrToMemData>... names)
     {
         static_assert(NICKEL_IS_RVALUE_REFERENCE(Class &&),
             "Object must be an rvalue. Pass std::move(*this) to nickel::steal(...)");
 
-        using check_group_t = decltype(nickel::name_group(NICKEL_MOVE(names)...));
+        // Members are requested with 0-arg setters: `.<name>()`
+        using members_t = detail::storage<
+            detail::named<decltype(Names {}.template multivalued<0>()), PtrToMemData>...>;
 
-        static_assert(!check_group_t::_has_kwargs(detail::priv_tag {}),
-            "nickel::steal(...) cannot accept kwargs");
+        return detail::steal_fn<std::remove_reference_t<Class>, members_t,
+            detail::names_t<decltype(Names {}.template multivalued<0>())...>, detail::names_t<>> {
+            detail::construct_tag {},
+            members_t {
+                detail::construct_tag {},
+                detail::named<decltype(Names {}.template multivalued<0>()), PtrToMemData> {
+                    names.value,
+                }...,
+            },
+            detail::addressof(object),
+        };
+    }
 
-        return nickel::name_group((Names {}.template multivalued<0>() = names.value)...)
-            ._make_steal_wrapped_fn(detail::priv_tag {}, std::addressof(object));
+// The `.name<V>()` setter, which passes nickel::c<V>. Needs C++17's `template <auto V>`.
+#ifdef __cpp_nontype_template_parameter_auto
+#define NICKEL_DETAIL_CONSTANT_SETTER(variable, name)                                              \
+    template <auto V>                                                                              \
+    NICKEL_DETAIL_INLINE constexpr auto name() &&                                                  \
+    {                                                                                              \
+        static_assert(N == -1, "Must call the function with the specified arguments: " #name);     \
+        return static_cast<Derived&&>(*this)(::nickel::detail::set_tag {},                         \
+            variable##_nickel_name_type {}, ::nickel::detail::int_t<N> {}, ::nickel::c<V>);        \
     }
+#else
+#define NICKEL_DETAIL_CONSTANT_SETTER(variable, name)
+#endif
 
 // Creates a name. This is the 2-arg overload.
 #define NICKEL_DETAIL_NAME2(variable, name)                                                        \
@@ -789,14 +2942,17 @@ namespace nickel {
         struct set_type                                                                            \
         {                                                                                          \
             template <typename... Ts>                                                              \
-            constexpr auto name(Ts&&... values) &&                                                 \
+            NICKEL_DETAIL_INLINE constexpr auto name(Ts&&... values) &&                            \
             {                                                                                      \
-                static_assert(sizeof...(Ts) == N || (sizeof...(Ts) == 1 && N == -1),               \
+                static_assert(                                                                     \
+                    sizeof...(Ts) == N || (sizeof...(Ts) == 1 && N == -1) || N == -2,              \
                     "Must call the function with the specified arguments: " #name);                \
                 return static_cast<Derived&&>(*this)(::nickel::detail::set_tag {},                 \
                     variable##_nickel_name_type {}, ::nickel::detail::int_t<N> {},                 \
                     NICKEL_DETAIL_FWD(values)...);                                                 \
             }                                                                                      \
+                                                                                                   \
+            NICKEL_DETAIL_CONSTANT_SETTER(variable, name)                                          \
         };                                                                                         \
                                                                                                    \
         template <typename Derived>                                                                \
@@ -833,6 +2989,12 @@ namespace nickel {
             };                                                                                     \
         }                                                                                          \
                                                                                                    \
+        /* Any number of values of one type, passed as a nickel::values<T>. */                     \
+        constexpr auto multivalued() const -> variable##_nickel_name_type<-2>                      \
+        {                                                                                          \
+            return {};                                                                             \
+        }                                                                                          \
+                                                                                                   \
         template <int NArgs>                                                                       \
         constexpr auto multivalued() const -> variable##_nickel_name_type<NArgs>                   \
         {                                                                                          \
@@ -861,6 +3023,20 @@ namespace nickel {
         __VA_ARGS__, NICKEL_DETAIL_NAME2, NICKEL_DETAIL_NAME1, )(__VA_ARGS__))
 }
 
+// Enables structured bindings for the result of nickel::steal(...)
+namespace std {
+    template <typename Class, typename Members, typename Names, typename Selected, typename... Ts>
+    struct tuple_size<::nickel::detail::stolen<Class, Members, Names, Selected, Ts...>>
+        : std::integral_constant<std::size_t, sizeof...(Ts)>
+    { };
+
+    template <std::size_t I, typename Class, typename Members, typename Names, typename Selected,
+        typename... Ts>
+    struct tuple_element<I, ::nickel::detail::stolen<Class, Members, Names, Selected, Ts...>>
+        : std::tuple_element<I, std::tuple<Ts...>>
+    { };
+}
+
 #undef NICKEL_FWD
 #undef NICKEL_MOVE
 #undef NICKEL_IS_VOID
@@ -0,0 +1,185 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NICKEL_SOA_H_2F6B90C4
+#define NICKEL_SOA_H_2F6B90C4
+
+// nickel::soa(...) and nickel::for_each_row(...) live in their own header, as the columns need
+// <vector>, which most users of nickel.hpp shouldn't have to compile.
+
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+#include <iterator> // std::begin, std::end, std::distance
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace nickel {
+    namespace detail {
+        // A struct-of-arrays table: one contiguous column per name (see nickel::soa).
+        // `.<name>()` accesses the column; each row can be passed to a nickel-wrapped function like
+        // kwargs, referring to that row's element of each column.
+        template <typename Columns, typename Names>
+        class soa;
+
+        template <typename Columns, typename... Names>
+        class soa<Columns, names_t<Names...>>
+            : public Names::template get_type<soa<Columns, names_t<Names...>>>...
+        {
+        private:
+            Columns columns_;
+
+            // The `index`th row of `columns`: each name refers to its column's element.
+            template <typename Self>
+            static constexpr auto row(Self& columns, std::size_t index)
+            {
+                using row_storage_t
+                    = storage<named<Names, decltype(columns.get(tag_t<Names> {})[index])>...>;
+
+                return named_view<row_storage_t, names_t<Names...>> {
+                    construct_tag {},
+                    row_storage_t {
+                        construct_tag {},
+                        named<Names, decltype(columns.get(tag_t<Names> {})[index])> {
+                            columns.get(tag_t<Names> {})[index],
+                        }...,
+                    },
+                };
+            }
+
+        public:
+            explicit soa(construct_tag, Columns&& columns)
+                : columns_ {NICKEL_DETAIL_MOVE(columns)}
+            { }
+
+            // NOT PUBLIC API
+            // Retrieves the column for `Name`; implements the `.<name>()` accessors.
+            template <typename Name>
+            constexpr decltype(auto) operator()(get_tag, Name) &
+            {
+                return columns_.get(tag_t<Name> {});
+            }
+
+            template <typename Name>
+            constexpr decltype(auto) operator()(get_tag, Name) const&
+            {
+                return columns_.get(tag_t<Name> {});
+            }
+
+            template <typename Name>
+            constexpr decltype(auto) operator()(get_tag, Name) &&
+            {
+                return NICKEL_DETAIL_MOVE(columns_).get(tag_t<Name> {});
+            }
+
+            template <typename Name>
+            constexpr decltype(auto) operator()(get_tag, Name) const&&
+            {
+                return NICKEL_DETAIL_MOVE(columns_).get(tag_t<Name> {});
+            }
+
+            // NOT PUBLIC API
+            // The number of rows. The columns can be resized through `.<name>()`, so this checks
+            // that they still have the same length.
+            std::size_t _size(priv_tag) const
+            {
+                std::size_t const sizes[] = {columns_.get(tag_t<Names> {}).size()...};
+                for (std::size_t size : sizes) {
+                    if (size != sizes[0])
+                        throw std::length_error("nickel: the columns have different lengths");
+                }
+                return sizes[0];
+            }
+
+            // NOT PUBLIC API
+            // The `index`th row, as kwargs referring to the elements of each column.
+            constexpr auto _row(priv_tag, std::size_t index) &
+            {
+                return soa::row(columns_, index);
+            }
+
+            constexpr auto _row(priv_tag, std::size_t index) const&
+            {
+                return soa::row(columns_, index);
+            }
+        };
+
+        // Calls a function which lives elsewhere, so that a call can refer to it rather than copy
+        // it (see nickel::for_each_row).
+        template <typename Fn>
+        struct fn_ref
+        {
+            Fn* fn;
+
+            template <typename... Args>
+            constexpr decltype(auto) operator()(Args&&... args) const
+            {
+                return (*fn)(NICKEL_DETAIL_FWD(args)...);
+            }
+        };
+    }
+
+    // EXPERIMENTAL
+    // Builds a struct-of-arrays table from a range of objects, with one std::vector column per
+    // name, declared like nickel::steal(...): `name = &Class::member`.
+    //   auto table = nickel::soa(points, x = &Point::x, y = &Point::y);
+    //   table.x(); // std::vector<double>&
+    template <typename Range, typename... Names, typename... PtrToMemData>
+    auto soa(Range const& objects, detail::defaulted<Names, PtrToMemData>... names)
+    {
+        static_assert(sizeof...(Names) != 0, "nickel::soa(...) requires at least one column");
+
+        using columns_t = detail::storage<detail::named<Names,
+            std::vector<typename detail::member_type<PtrToMemData>::type>>...>;
+
+        auto const rows = static_cast<std::size_t>(
+            std::distance(std::begin(objects), std::end(objects)));
+
+        columns_t columns {
+            detail::construct_tag {},
+            detail::named<Names, std::vector<typename detail::member_type<PtrToMemData>::type>> {
+                {},
+            }...,
+        };
+        int reserve[] = {(columns.get(detail::tag_t<Names> {}).reserve(rows), 0)...};
+        (void)reserve;
+
+        for (auto const& object : objects) {
+            int push[] = {
+                (columns.get(detail::tag_t<Names> {}).push_back(object.*(names.value)), 0)...,
+            };
+            (void)push;
+        }
+
+        return detail::soa<columns_t, detail::names_t<Names...>> {
+            detail::construct_tag {},
+            NICKEL_DETAIL_MOVE(columns),
+        };
+    }
+
+    // EXPERIMENTAL
+    // Calls `fn` once per row of `table` (a nickel::soa(...)), passing the row like kwargs. Each
+    // parameter refers to the row's element of the column, so `fn` may also write to the columns.
+    //   nickel::for_each_row(table, length()); // where length() is a nickel-wrapped function
+    // `fn` is a nickel-wrapped function before any arguments are set. It is copied once; each row
+    // only copies its default arguments. Throws std::length_error if the columns have been resized
+    // to different lengths.
+    template <typename Table, typename WrappedFn>
+    void for_each_row(Table& table, WrappedFn const& fn)
+    {
+        std::size_t const rows = table._size(detail::priv_tag {});
+
+        WrappedFn bound {fn};
+        auto const refer = [](auto& callable) {
+            return detail::fn_ref<std::remove_reference_t<decltype(callable)>> {&callable};
+        };
+        for (std::size_t index = 0; index < rows; ++index) {
+            bound._map_fn(detail::priv_tag {}, refer)(table._row(detail::priv_tag {}, index))();
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,340 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NICKEL_THIN_H_A41C7E29
+#define NICKEL_THIN_H_A41C7E29
+
+// nickel::wrap_thin(...) lives in its own header. Thin mode is opt-in per function: it trades the
+// compile-time checks for missing and repeated arguments for runtime ones.
+
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+#include <memory> // std::addressof
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace nickel {
+    namespace detail {
+        // Whether `Name` takes a single value, rather than being multivalued.
+        template <template <int> class Name, int N>
+        constexpr bool is_single_valued(tag_t<Name<N>>)
+        {
+            return N == -1;
+        }
+
+        // nickel::rest takes any number of arguments.
+        constexpr bool is_single_valued(tag_t<rest_name>)
+        {
+            return false;
+        }
+
+        template <typename... Names>
+        constexpr bool all_single_valued()
+        {
+            constexpr bool single_valued[] = {true, detail::is_single_valued(tag_t<Names> {})...};
+            for (bool single : single_valued) {
+                if (!single) return false;
+            }
+            return true;
+        }
+
+        // An argument bound in thin mode (see nickel::wrap_thin).
+        // `source` points at the argument. If it cannot bind directly to the parameter,
+        // `construct` converts it into a temporary of the parameter's type at call time.
+        struct thin_slot
+        {
+            void* source = nullptr;
+            void (*construct)(void* source, void* buffer) = nullptr;
+        };
+
+        template <typename Value, typename T>
+        void thin_construct(void* source, void* buffer)
+        {
+            ::new (buffer)
+                Value(static_cast<T&&>(*static_cast<std::remove_reference_t<T>*>(source)));
+        }
+
+        template <typename Value, typename Deferred>
+        void thin_construct_default(void* source, void* buffer)
+        {
+            ::new (buffer)
+                Value(detail::get_default(NICKEL_DETAIL_MOVE(*static_cast<Deferred*>(source))));
+        }
+
+        // Calls the conversion directly: as a constructor argument, it would be ambiguous with any
+        // other constructor which the in_place_args could also convert to an argument for.
+        template <typename Value, typename InPlace>
+        void thin_construct_in_place(void* source, void* buffer)
+        {
+            ::new (buffer)
+                Value(NICKEL_DETAIL_MOVE(*static_cast<InPlace*>(source)).operator Value());
+        }
+
+        template <typename P, typename T>
+        void thin_bind_(std::true_type /* binds directly */, thin_slot& slot, T&& value)
+        {
+            slot.source = const_cast<remove_cvref_t<P>*>(
+                static_cast<std::remove_reference_t<P>*>(std::addressof(value)));
+            slot.construct = nullptr;
+        }
+
+        template <typename P, typename T>
+        void thin_bind_(std::false_type /* binds directly */, thin_slot& slot, T&& value)
+        {
+            slot.source = const_cast<remove_cvref_t<T>*>(std::addressof(value));
+            slot.construct = &detail::thin_construct<remove_cvref_t<P>, T>;
+        }
+
+        // Binds `value` to the slot for a parameter of type `P`.
+        template <typename P, typename T>
+        void thin_bind(thin_slot& slot, T&& value)
+        {
+            static_assert(std::is_convertible<T&&, P>::value,
+                "The argument cannot be converted to the parameter's type");
+
+            detail::thin_bind_<P>(std::integral_constant<bool,
+                                      std::is_reference<P>::value
+                                          && std::is_convertible<std::remove_reference_t<T>*,
+                                              std::remove_reference_t<P>*>::value> {},
+                slot, NICKEL_DETAIL_FWD(value));
+        }
+
+        // Deferred default arguments are only called if they are needed.
+        template <typename P, typename Lambda>
+        void thin_bind(thin_slot& slot, deferred<Lambda>&& fn)
+        {
+            slot.source = std::addressof(fn);
+            slot.construct = &detail::thin_construct_default<remove_cvref_t<P>, deferred<Lambda>>;
+        }
+
+        template <typename P, typename Lambda, typename... Deps>
+        void thin_bind(thin_slot&, deferred_from<Lambda, Deps...>&&)
+        {
+            static_assert(sizeof(Lambda) == 0,
+                "A default argument computed from other names is not supported in thin mode");
+        }
+
+        template <typename P, typename... Args>
+        void thin_bind(thin_slot& slot, in_place_args<Args...>&& args)
+        {
+            static_assert(std::is_constructible<remove_cvref_t<P>, Args&&...>::value,
+                "The parameter cannot be constructed from the nickel::in_place(...) arguments");
+
+            slot.source = std::addressof(args);
+            slot.construct
+                = &detail::thin_construct_in_place<remove_cvref_t<P>, in_place_args<Args...>>;
+        }
+
+        // Checks that a slot without a default argument was set.
+        inline void thin_require(thin_slot const& slot)
+        {
+            if (!slot.source) throw std::invalid_argument("nickel: missing a required argument");
+        }
+
+        // Holds the temporary for a converted thin_arg.
+        // Trivially destructible values need no cleanup, which keeps the call itself small.
+        template <typename Value, bool = std::is_trivially_destructible<Value>::value>
+        struct thin_buffer
+        {
+            void* source;
+            alignas(Value) unsigned char buffer[sizeof(Value)];
+        };
+
+        template <typename Value>
+        struct thin_buffer<Value, false>
+        {
+            void* source;
+            alignas(Value) unsigned char buffer[sizeof(Value)];
+            bool owns = false;
+
+            thin_buffer() = default;
+            thin_buffer(thin_buffer const&) = delete;
+            thin_buffer& operator=(thin_buffer const&) = delete;
+
+            ~thin_buffer()
+            {
+                if (owns) detail::destroy_value(*static_cast<Value*>(source));
+            }
+        };
+
+        template <typename Value>
+        void thin_own(thin_buffer<Value, true>&)
+        { }
+
+        template <typename Value>
+        void thin_own(thin_buffer<Value, false>& buffer)
+        {
+            buffer.owns = true;
+        }
+
+        // The argument for a parameter of type `P`, read from a thin_slot at call time.
+        // Lives until the end of the call, so it holds any converted temporary.
+        template <typename P>
+        class thin_arg : private thin_buffer<remove_cvref_t<P>>
+        {
+        public:
+            explicit thin_arg(thin_slot const& slot)
+            {
+                this->source = slot.source;
+                if (slot.construct) {
+                    slot.construct(slot.source, this->buffer);
+                    this->source = this->buffer;
+                    detail::thin_own(*this);
+                }
+            }
+
+            P get() &&
+            {
+                return static_cast<P&&>(*static_cast<std::remove_reference_t<P>*>(this->source));
+            }
+        };
+
+        // Maps each name of a thin_fn to its slot index and parameter type in one lookup.
+        template <std::size_t I, typename Name, typename P>
+        struct thin_param
+        {
+            static constexpr std::size_t index = I;
+            using type = P;
+        };
+
+        template <typename Indices, typename Names, typename Params>
+        struct thin_params;
+
+        template <std::size_t... Is, typename... Names, typename... Params>
+        struct thin_params<std::index_sequence<Is...>, names_t<Names...>, type_list<Params...>>
+            : thin_param<Is, Names, Params>...
+        { };
+
+        template <typename Name, std::size_t I, typename P>
+        thin_param<I, Name, P> find_thin_param(thin_param<I, Name, P> const*);
+
+        // The builder for nickel::wrap_thin(...).
+        // Unlike wrapped_fn, the type does not change as arguments are set: every setter writes
+        // the argument's address into a slot, and the call converts the slots to the parameters.
+        template <typename Defaults, typename Fn, typename Params, typename Names>
+        class thin_fn;
+
+        template <typename Defaults, typename Fn, typename... Params, typename... Names>
+        class thin_fn<Defaults, Fn, type_list<Params...>, names_t<Names...>>
+            : public Names::template set_type<
+                  thin_fn<Defaults, Fn, type_list<Params...>, names_t<Names...>>>...
+        {
+            static_assert(sizeof...(Params) == sizeof...(Names),
+                "nickel::wrap_thin(...) requires one name per parameter");
+            static_assert(detail::all_single_valued<Names...>(),
+                "nickel::wrap_thin(...) does not support multivalued names");
+
+        private:
+            Defaults defaults_;
+            Fn fn_;
+            thin_slot slots_[sizeof...(Names) + 1];
+
+            // Fills in an unset slot with the default argument.
+            template <typename Name, typename P>
+            void fill(std::true_type, tag_t<Name> id, tag_t<P>, thin_slot& slot)
+            {
+                if (!slot.source) detail::thin_bind<P>(slot, NICKEL_DETAIL_MOVE(defaults_).get(id));
+            }
+
+            template <typename Name, typename P>
+            static void fill(std::false_type, tag_t<Name>, tag_t<P>, thin_slot& slot)
+            {
+                detail::thin_require(slot);
+            }
+
+            template <std::size_t... Is>
+            decltype(auto) call(std::index_sequence<Is...>)
+            {
+                return NICKEL_DETAIL_MOVE(fn_)(thin_arg<Params> {slots_[Is]}.get()...);
+            }
+
+        public:
+            template <typename FDefaults, typename FFn>
+            explicit constexpr thin_fn(FDefaults&& defaults, FFn&& fn)
+                : defaults_ {NICKEL_DETAIL_FWD(defaults)}
+                , fn_ {NICKEL_DETAIL_FWD(fn)}
+                , slots_ {}
+            { }
+
+            // Bind the name to the single argument.
+            // NOT PUBLIC API
+            template <typename Name, typename T>
+            thin_fn&& operator()(set_tag, Name, int_t<-1>, T&& value) &&
+            {
+                using param_t = decltype(detail::find_thin_param<Name>(
+                    static_cast<thin_params<std::index_sequence_for<Names...>, names_t<Names...>,
+                        type_list<Params...>> const*>(nullptr)));
+                constexpr std::size_t index = param_t::index;
+                using P = typename param_t::type;
+
+                if (slots_[index].source)
+                    throw std::invalid_argument("nickel: an argument was set more than once");
+                detail::thin_bind<P>(slots_[index], NICKEL_DETAIL_FWD(value));
+
+                return NICKEL_DETAIL_MOVE(*this);
+            }
+
+            // Call the function with bound arguments.
+            // Throws std::invalid_argument if a name without a default was not set.
+            decltype(auto) operator()() &&
+            {
+                thin_slot* slot = slots_;
+                int expand[] = {0,
+                    (this->fill(std::integral_constant<bool, Defaults::template is_set<Names>> {},
+                         tag_t<Names> {}, tag_t<Params> {}, *slot++),
+                        0)...};
+                (void)expand;
+
+                return this->call(std::index_sequence_for<Params...> {});
+            }
+        };
+
+        // nickel::wrap_thin(names...), but without the second parentheses.
+        template <typename Defaults, typename Kwargs, typename Names>
+        class partial_wrap<Defaults, Kwargs, Names, true> : private Defaults
+        {
+        public:
+            template <typename FDefaults>
+            explicit constexpr partial_wrap(construct_tag, FDefaults&& defaults)
+                : Defaults {NICKEL_DETAIL_FWD(defaults)}
+            { }
+
+            template <typename Fn>
+            constexpr auto operator()(Fn&& fn) &&
+            {
+                using DFn = stored_fn_t<remove_cvref_t<Fn>>;
+
+                static_assert(fn_signature<DFn>::fixed,
+                    "nickel::wrap_thin(...) requires a function with a single, non-template "
+                    "signature");
+                static_assert(std::is_same<Kwargs, names_t<>>::value,
+                    "nickel::wrap_thin(...) does not support kwargs");
+
+                return thin_fn<Defaults, DFn, typename fn_signature<DFn>::params, Names> {
+                    static_cast<Defaults&&>(*this),
+                    NICKEL_DETAIL_FWD(fn),
+                };
+            }
+        };
+    }
+
+    // EXPERIMENTAL
+    // Like nickel::wrap(...), but builds a "thin" function whose type does not change as arguments
+    // are set. This is much cheaper to compile, at the cost of some runtime indirection.
+    // The function must have a single, non-template signature, with one parameter per name.
+    // Kwargs and multivalued names are not supported. Missing arguments are reported at runtime by
+    // throwing std::invalid_argument, as is setting an argument twice.
+    template <typename... Names>
+    constexpr auto wrap_thin(Names&&... names)
+    {
+        return nickel::name_group(NICKEL_DETAIL_FWD(names)...)(
+            detail::name_group_to_partial_fn_tag {}, detail::thin_tag {});
+    }
+}
+
+#endif
@@ -0,0 +1,25 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+#include <string>
+
+NICKEL_NAME(text, text);
+
+auto function()
+{
+    return nickel::wrap(text)([](auto const& text) { return std::string(text).size(); });
+}
+
+std::size_t test()
+{
+    alignas(std::max_align_t) unsigned char buffer[256];
+    nickel::arena arena(buffer);
+
+    // The type to construct is not known, so the arguments cannot be kept.
+    return nickel::materialize(function().text(nickel::in_place(3, 'x')), arena)();
+}
@@ -0,0 +1,26 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+
+NICKEL_NAME(x, x);
+NICKEL_NAME(y, y);
+
+auto function()
+{
+    return nickel::wrap(x, y)([](int x, int y) { return x + y; });
+}
+
+int test()
+{
+    alignas(std::max_align_t) unsigned char buffer[256];
+    nickel::arena arena(buffer);
+
+    // y is required, but never set; reported here rather than at the call.
+    auto materialized = nickel::materialize(function().x(1), arena);
+    return materialized();
+}
@@ -0,0 +1,17 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/memoize.hpp>
+
+NICKEL_NAME(x, x);
+
+void print(int)
+{ }
+
+void test()
+{
+    // There is no result to cache.
+    nickel::memoize(nickel::wrap(x)(print), 4);
+}
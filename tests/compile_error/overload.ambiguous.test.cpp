@@ -0,0 +1,22 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+NICKEL_NAME(x, x);
+NICKEL_NAME(y, y);
+
+auto function()
+{
+    return nickel::overload( //
+        nickel::wrap(x)([](int x) { return x; }),
+        nickel::wrap(x, y = 1)([](int x, int y) { return x + y; }));
+}
+
+int test()
+{
+    // Both overloads can be called with just x.
+    return function().x(1)();
+}
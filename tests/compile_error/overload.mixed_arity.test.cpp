@@ -0,0 +1,19 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+#include <tuple>
+
+NICKEL_NAME(x, x);
+NICKEL_NAME(y, y);
+
+void test()
+{
+    // x takes one value in the first function, but two in the second.
+    nickel::overload( //
+        nickel::wrap(x, y)([](int x, int y) { return x + y; }),
+        nickel::wrap(x.multivalued<2>())([](auto const& xs) { return std::get<0>(xs); }));
+}
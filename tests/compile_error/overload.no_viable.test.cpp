@@ -0,0 +1,23 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+NICKEL_NAME(x, x);
+NICKEL_NAME(y, y);
+NICKEL_NAME(z, z);
+
+auto function()
+{
+    return nickel::overload( //
+        nickel::wrap(x, y)([](int x, int y) { return x + y; }),
+        nickel::wrap(z)([](int z) { return z; }));
+}
+
+int test()
+{
+    // Neither overload takes x and z.
+    return function().x(1).z(2)();
+}
@@ -0,0 +1,21 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+NICKEL_NAME(x, x);
+NICKEL_NAME(y, y);
+
+auto function()
+{
+    // Each default is computed from the other.
+    return nickel::wrap(x = nickel::deferred([](int y) { return y; }, y),
+        y = nickel::deferred([](int x) { return x; }, x))([](int x, int y) { return x + y; });
+}
+
+int test()
+{
+    return function().x(1)();
+}
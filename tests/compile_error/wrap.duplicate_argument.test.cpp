@@ -0,0 +1,28 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+NICKEL_NAME(x_name, x);
+NICKEL_NAME(y_name, y);
+
+struct Point
+{
+    int x;
+    int y;
+};
+
+auto function()
+{
+    return nickel::wrap(x_name, y_name)([](int x, int y) { return x + y; });
+}
+
+int test()
+{
+    Point point {1, 2};
+
+    // x is set, then passed again through the view.
+    return function().x(1)(nickel::view(point, x_name = &Point::x, y_name = &Point::y))();
+}
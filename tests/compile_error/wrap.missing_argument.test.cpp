@@ -0,0 +1,21 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+NICKEL_NAME(x, x);
+NICKEL_NAME(y, y);
+NICKEL_NAME(z, z);
+
+auto function()
+{
+    return nickel::wrap(x, y, z = 3)([](int x, int y, int z) { return x + y + z; });
+}
+
+int test()
+{
+    // y is required, but never set.
+    return function().x(1)();
+}
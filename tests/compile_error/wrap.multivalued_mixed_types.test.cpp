@@ -0,0 +1,19 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+NICKEL_NAME(ids, ids);
+
+auto function()
+{
+    return nickel::wrap(ids.multivalued())([](nickel::values<int> ids) { return ids.size(); });
+}
+
+int test()
+{
+    // A .multivalued() name takes values of a single type.
+    return static_cast<int>(function().ids(1, 2L)());
+}
@@ -0,0 +1,20 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+NICKEL_NAME(x, x);
+NICKEL_NAME(y, y);
+
+auto function()
+{
+    return nickel::wrap(x)([](int x) { return x; });
+}
+
+int test()
+{
+    // y is not a name of the function, and it has no nickel::rest.
+    return function()(x = 1)(y = 2)();
+}
@@ -0,0 +1,83 @@
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+#include <catch2/catch.hpp>
+
+namespace {
+    NICKEL_NAME(x, x);
+    NICKEL_NAME(base, base);
+
+    template <int V>
+    using int_c = std::integral_constant<int, V>;
+
+    // Returns the base, plus 1000 if it was known at compile time.
+    struct describe_base
+    {
+        int operator()(int x, int base) const
+        {
+            return x + base;
+        }
+
+        template <int Base>
+        int operator()(int x, int_c<Base>) const
+        {
+            return x + Base + 1000;
+        }
+    };
+
+    auto describe()
+    {
+        return nickel::wrap(x, base = int_c<10> {})(describe_base {});
+    }
+}
+
+TEST_CASE("std::integral_constant arguments reach the function as constants")
+{
+    CHECK(describe().x(1)() == 1011);
+    CHECK(describe().x(1).base(int_c<2> {})() == 1003);
+    CHECK(describe().x(1).base(2)() == 3);
+}
+
+TEST_CASE("std::integral_constant arguments take no space in the builder")
+{
+    int x_value = 1;
+    auto without = describe().x(x_value);
+    auto with = describe().x(x_value).base(int_c<2> {});
+
+    CHECK(sizeof(with) == sizeof(without));
+    CHECK(sizeof(describe().base(int_c<2> {})) == sizeof(describe()));
+}
+
+TEST_CASE("std::integral_constant arguments can be materialized")
+{
+    alignas(std::max_align_t) unsigned char buffer[64];
+    nickel::arena arena(buffer);
+
+    auto call = nickel::materialize(describe().x(1).base(int_c<2> {}), arena);
+    CHECK(std::move(call)() == 1003);
+}
+
+#if __cplusplus >= 201703L
+TEST_CASE("nickel::c<V> and .name<V>() pass compile-time arguments")
+{
+    auto fn = [] {
+        return nickel::wrap(x, base = nickel::c<10>)([](int x, auto base) {
+            if constexpr (decltype(base)::value == 10) {
+                return x * 10;
+            } else {
+                return x + base;
+            }
+        });
+    };
+
+    CHECK(fn().x(3)() == 30);
+    CHECK(fn().x(3).base(nickel::c<2>)() == 5);
+    CHECK(fn().x(3).base<2>()() == 5);
+    CHECK(fn().base<10>().x(4)() == 40);
+
+    static_assert(std::is_same<decltype(nickel::c<2>), std::integral_constant<int, 2> const>::value,
+        "nickel::c<V> is a std::integral_constant");
+}
+#endif
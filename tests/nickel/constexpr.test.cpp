@@ -0,0 +1,204 @@
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+// Every feature which doesn't need the heap, type erasure, or an arena (nickel::wrap_thin,
+// nickel::materialize, nickel::memoize) works in constant expressions. These are checked by the
+// static_asserts: this file compiling is the test.
+
+namespace {
+    NICKEL_NAME(x, x);
+    NICKEL_NAME(y, y);
+    NICKEL_NAME(z, z);
+    NICKEL_NAME(to, to);
+
+    // Function objects rather than lambdas, which are only constexpr since C++17.
+    struct add
+    {
+        constexpr int operator()(int x, int y) const
+        {
+            return x + 10 * y;
+        }
+    };
+
+    struct seven
+    {
+        constexpr int operator()() const
+        {
+            return 7;
+        }
+    };
+
+    constexpr auto adder()
+    {
+        return nickel::wrap(x, y = 2)(add {});
+    }
+
+    static_assert(adder().x(1).y(3)() == 31, "setters");
+    static_assert(adder().y(3).x(1)() == 31, "setters, out of order");
+    static_assert(adder().x(1)() == 21, "default arguments");
+    static_assert(adder()(x = 1, y = 4)() == 41, "(name = value) arguments");
+
+    constexpr auto deferred_adder()
+    {
+        return nickel::wrap(x, y = nickel::deferred(seven {}))(add {});
+    }
+
+    static_assert(deferred_adder().x(1)() == 71, "deferred default arguments");
+    static_assert(deferred_adder().x(1).y(0)() == 1, "overridden deferred default arguments");
+
+    constexpr auto grouped()
+    {
+        return nickel::wrap(nickel::name_group(x, y = 5))(add {});
+    }
+
+    static_assert(grouped().x(1)() == 51, "name groups");
+
+    struct forward_kwargs
+    {
+        template <typename Kwargs>
+        constexpr int operator()(Kwargs&& kwargs, int z) const
+        {
+            return adder()(static_cast<Kwargs&&>(kwargs))() + 100 * z;
+        }
+    };
+
+    static_assert(nickel::wrap(nickel::kwargs_group(x, y), z)(forward_kwargs {}).x(1).y(2).z(3)()
+            == 321,
+        "kwargs");
+
+    struct forward_rest
+    {
+        template <typename Rest>
+        constexpr int operator()(int z, Rest&& rest) const
+        {
+            return forward_kwargs {}(static_cast<Rest&&>(rest), z);
+        }
+    };
+
+    static_assert(nickel::wrap(z, nickel::rest)(forward_rest {}).z(3)(x = 1)() == 321, "rest");
+
+    struct sum_pair
+    {
+        template <typename Tuple>
+        constexpr int operator()(Tuple to) const
+        {
+            return std::get<0>(to) + 10 * std::get<1>(to);
+        }
+    };
+
+    static_assert(nickel::wrap(to.multivalued<2>())(sum_pair {}).to(1, 2)() == 21, "multivalued");
+
+    struct point
+    {
+        int x;
+        int y;
+    };
+
+    constexpr int view_point()
+    {
+        point p {3, 4};
+        return adder()(nickel::view(p, x = &point::x, y = &point::y))();
+    }
+
+    static_assert(view_point() == 43, "nickel::view");
+
+    constexpr int steal_point()
+    {
+        auto stolen = nickel::steal(point {1, 2}, x = &point::x, y = &point::y).y().x()();
+        return std::get<0>(stolen) + 10 * std::get<1>(stolen);
+    }
+
+    static_assert(steal_point() == 12, "nickel::steal");
+
+    struct product
+    {
+        int value;
+
+        constexpr product(int a, int b)
+            : value {a * b}
+        { }
+    };
+
+    struct take_product
+    {
+        constexpr int operator()(product p) const
+        {
+            return p.value;
+        }
+    };
+
+    static_assert(nickel::wrap(x)(take_product {}).x(nickel::in_place(3, 4))() == 12,
+        "nickel::in_place");
+
+    struct identity
+    {
+        constexpr int operator()(int z) const
+        {
+            return z;
+        }
+    };
+
+    static_assert(nickel::overload(adder(), nickel::wrap(z)(identity {})).z(4)() == 4,
+        "nickel::overload");
+
+    static_assert(nickel::wrap(x, y)(add {}).x(1).y(std::integral_constant<int, 2> {})() == 21,
+        "std::integral_constant arguments");
+
+    // A table computed at compile time through a nickel-wrapped function.
+    struct table_t
+    {
+        int values[16];
+    };
+
+    constexpr table_t make_table()
+    {
+        table_t table {};
+        for (int i = 0; i != 16; ++i) {
+            table.values[i] = adder().x(i)();
+        }
+        return table;
+    }
+
+    constexpr table_t table = make_table();
+    static_assert(table.values[15] == 35, "loops of calls");
+
+#if __cplusplus >= 201703L
+    constexpr auto square()
+    {
+        return nickel::wrap(x, y = nickel::c<2>)([](int x, auto y) {
+            if constexpr (decltype(y)::value == 2) {
+                return x * x;
+            } else {
+                return x * y;
+            }
+        });
+    }
+
+    static_assert(square().x(3)() == 9, "lambdas and nickel::c<V>");
+    static_assert(square().x(3).y<1>()() == 3, ".name<V>()");
+#endif
+
+#if __cplusplus >= 202002L
+    // Defaults computed from other names are constructed in place, which needs C++20.
+    constexpr auto dependent()
+    {
+        return nickel::wrap(x, y = nickel::deferred([](int x) { return x * 2; }, x))(add {});
+    }
+
+    static_assert(dependent().x(1)() == 21, "defaults computed from other names");
+    static_assert(dependent().x(1).y(1)() == 11, "overridden defaults computed from other names");
+#endif
+}
+
+TEST_CASE("Tables computed at compile time match those computed at runtime")
+{
+    table_t const runtime = make_table();
+    for (std::size_t i = 0; i != 16; ++i) {
+        CHECK(runtime.values[i] == table.values[i]);
+    }
+}
@@ -1,6 +1,7 @@
 #include <nickel/nickel.hpp>
 
 #include <ostream>
+#include <string>
 #include <utility>
 
 #include <catch2/catch.hpp>
@@ -10,6 +11,10 @@ namespace {
     constexpr auto int_c = std::integral_constant<int, V> {};
 
     NICKEL_NAME(base, base);
+    NICKEL_NAME(width, width);
+    NICKEL_NAME(height, height);
+    NICKEL_NAME(area, area);
+    NICKEL_NAME(label, label);
 
     auto my_log(double operand)
     {
@@ -60,3 +65,69 @@ TEST_CASE("Deferred default arguments remain unevaluated if unused")
     CHECK(result == 1);
     CHECK(modify_checker == 1);
 }
+
+TEST_CASE("Deferred defaults can be computed from other arguments")
+{
+    int calls = 0;
+
+    auto rectangle = [&] {
+        // Listed before the names they depend on: they are computed in dependency order.
+        return nickel::wrap(label = nickel::deferred(
+                                [&calls](int area) {
+                                    ++calls;
+                                    return "area " + std::to_string(area);
+                                },
+                                area),
+            area = nickel::deferred([](int width, int height) { return width * height; }, width,
+                height),
+            width, height = nickel::deferred([](int width) { return width; }, width))(
+            [](std::string label, int area, int width, int height) {
+                return label + " " + std::to_string(area) + " " + std::to_string(width) + "x"
+                    + std::to_string(height);
+            });
+    };
+
+    CHECK(rectangle().width(3)() == "area 9 9 3x3");
+    CHECK(rectangle().width(3).height(2)() == "area 6 6 3x2");
+    CHECK(rectangle().width(3).area(5)() == "area 5 5 3x3");
+    CHECK(calls == 3);
+
+    CHECK(rectangle().width(3).label("square")() == "square 9 3x3");
+    CHECK(calls == 3);
+}
+
+TEST_CASE("Dependent defaults see the arguments and plain defaults of other names")
+{
+    auto fn = [] {
+        return nickel::wrap(width = 2,
+            height = nickel::deferred([](int const& width) { return width + 1; }, width))(
+            [](int width, int height) { return 10 * width + height; });
+    };
+
+    CHECK(fn()() == 23);
+    CHECK(fn().width(5)() == 56);
+    CHECK(fn().height(7)() == 27);
+}
+
+TEST_CASE("Deferred defaults used by dependent defaults are only computed when needed")
+{
+    int width_calls = 0;
+
+    auto fn = [&] {
+        return nickel::wrap(width = nickel::deferred([&width_calls] {
+            ++width_calls;
+            return 4;
+        }),
+            height = nickel::deferred([](int width) { return width * 2; }, width))(
+            [](int width, int height) { return 10 * width + height; });
+    };
+
+    CHECK(fn()() == 48);
+    CHECK(width_calls == 1);
+
+    CHECK(fn().height(1)() == 41);
+    CHECK(width_calls == 2);
+
+    CHECK(fn().width(1).height(1)() == 11);
+    CHECK(width_calls == 2);
+}
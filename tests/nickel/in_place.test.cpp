@@ -0,0 +1,89 @@
+#include <nickel/nickel.hpp>
+#include <nickel/thin.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace {
+    NICKEL_NAME(text, text);
+    NICKEL_NAME(values, values);
+    NICKEL_NAME(item, item);
+
+    // Counts its moves and copies
+    struct counted
+    {
+        int value;
+        int* moves;
+
+        counted(int value, int* moves)
+            : value {value}
+            , moves {moves}
+        { }
+
+        counted(counted const& other)
+            : value {other.value}
+            , moves {other.moves}
+        {
+            ++*moves;
+        }
+
+        counted(counted&& other)
+            : value {other.value}
+            , moves {other.moves}
+        {
+            ++*moves;
+        }
+    };
+
+    auto describe()
+    {
+        return nickel::wrap(text, values = std::vector<int> {})(
+            [](std::string text, std::vector<int> const& values) {
+                return text + ":" + std::to_string(values.size());
+            });
+    }
+}
+
+TEST_CASE("nickel::in_place constructs the argument from its arguments")
+{
+    CHECK(describe().text(nickel::in_place(3, 'x'))() == "xxx:0");
+    CHECK(describe().values(nickel::in_place(5, 1)).text(nickel::in_place("abc"))() == "abc:5");
+    CHECK(describe()(values = nickel::in_place(2, 1), text = nickel::in_place(1, 'y'))() == "y:2");
+}
+
+TEST_CASE("nickel::in_place works in thin mode")
+{
+    auto fn = nickel::wrap_thin(text, values)([](std::string text, std::vector<int> const& values) {
+        return text + ":" + std::to_string(values.size());
+    });
+
+    CHECK(std::move(fn).values(nickel::in_place(4, 1)).text(nickel::in_place(2, 'z'))() == "zz:4");
+}
+
+#if __cplusplus >= 201703L
+TEST_CASE("nickel::in_place constructs the argument directly in the parameter")
+{
+    int moves = 0;
+    auto fn = nickel::wrap(item)([](counted item) { return item.value; });
+
+    CHECK(std::move(fn).item(nickel::in_place(42, &moves))() == 42);
+    CHECK(moves == 0);
+
+    struct immovable
+    {
+        int value;
+
+        explicit immovable(int value)
+            : value {value}
+        { }
+
+        immovable(immovable&&) = delete;
+    };
+
+    auto take = nickel::wrap(item)([](immovable item) { return item.value; });
+    CHECK(std::move(take).item(nickel::in_place(7))() == 7);
+}
+#endif
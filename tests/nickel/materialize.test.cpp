@@ -0,0 +1,195 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace {
+    NICKEL_NAME(name, name);
+    NICKEL_NAME(ids, ids);
+    NICKEL_NAME(point, point);
+    NICKEL_NAME(label, label);
+
+    bool in_buffer(void const* object, unsigned char const* buffer, std::size_t size)
+    {
+        auto const address = reinterpret_cast<std::uintptr_t>(object);
+        auto const begin = reinterpret_cast<std::uintptr_t>(buffer);
+        return begin <= address && address < begin + size;
+    }
+
+    struct counted
+    {
+        static int live;
+
+        counted()
+        {
+            ++live;
+        }
+
+        counted(counted const&)
+        {
+            ++live;
+        }
+
+        ~counted()
+        {
+            --live;
+        }
+    };
+
+    int counted::live = 0;
+}
+
+TEST_CASE("Materialized arguments live in the arena")
+{
+    alignas(std::max_align_t) unsigned char buffer[1024];
+    nickel::arena arena(buffer);
+
+    std::string const long_name = "A name which is too long for the small string optimization";
+    std::vector<int> const numbers {1, 2, 3};
+
+    bool called = false;
+    auto fn = [&] {
+        return nickel::wrap(name, ids)([&](std::string const& name, std::vector<int> const& ids) {
+            called = true;
+            CHECK(in_buffer(&name, buffer, sizeof(buffer)));
+            CHECK(in_buffer(&ids, buffer, sizeof(buffer)));
+            CHECK(name == long_name);
+            CHECK(ids == numbers);
+        });
+    };
+
+    auto call = nickel::materialize(fn().name(long_name).ids(numbers), arena);
+    CHECK(arena.remaining() < sizeof(buffer));
+    CHECK_FALSE(called);
+
+    std::move(call)();
+    CHECK(called);
+}
+
+TEST_CASE("Materialized arguments are owned copies")
+{
+    alignas(std::max_align_t) unsigned char buffer[256];
+    nickel::arena arena(buffer);
+
+    auto fn = [] {
+        return nickel::wrap(name, label = std::string("default"))(
+            [](std::string name, std::string label) { return name + ":" + label; });
+    };
+
+    auto call = [&] {
+        std::string temporary = "temporary";
+        return nickel::materialize(fn().name(temporary), arena);
+    }();
+
+    CHECK(std::move(call)() == "temporary:default");
+}
+
+TEST_CASE("Materializing multivalued arguments copies each value")
+{
+    alignas(std::max_align_t) unsigned char buffer[256];
+    nickel::arena arena(buffer);
+
+    auto fn = [] {
+        return nickel::wrap(point.multivalued<2>())(
+            [](auto point) { return std::get<0>(point) * 10 + std::get<1>(point); });
+    };
+
+    auto call = [&] {
+        int x = 4;
+        int y = 2;
+        return nickel::materialize(fn().point(x, y), arena);
+    }();
+
+    CHECK(std::move(call)() == 42);
+}
+
+TEST_CASE("Materializing dynamic multivalued arguments copies each value")
+{
+    alignas(std::max_align_t) unsigned char buffer[256];
+    nickel::arena arena(buffer);
+
+    auto fn = [&] {
+        return nickel::wrap(ids.multivalued())([&](nickel::values<int> ids) {
+            CHECK(in_buffer(&ids[0], buffer, sizeof(buffer)));
+            return ids[0] * 100 + ids[1] * 10 + ids[2];
+        });
+    };
+
+    auto call = [&] {
+        int x = 4;
+        int y = 2;
+        return nickel::materialize(fn().ids(x, y, 7), arena);
+    }();
+
+    CHECK(std::move(call)() == 427);
+}
+
+TEST_CASE("Materializing an in-place argument constructs the parameter's value")
+{
+    alignas(std::max_align_t) unsigned char buffer[256];
+    nickel::arena arena(buffer);
+
+    auto fn = [&] {
+        return nickel::wrap(name)([&](std::string const& name) {
+            CHECK(in_buffer(&name, buffer, sizeof(buffer)));
+            return name;
+        });
+    };
+
+    auto call = [&] {
+        std::string const temporary
+            = "A temporary which is too long for the small string optimization";
+        // The arguments refer into `temporary`, which is gone before the call.
+        return nickel::materialize(fn().name(nickel::in_place(temporary.c_str(), 11)), arena);
+    }();
+
+    CHECK(std::move(call)() == "A temporary");
+}
+
+TEST_CASE("Materialized arguments are destroyed exactly once")
+{
+    alignas(std::max_align_t) unsigned char buffer[256];
+    nickel::arena arena(buffer);
+
+    auto fn = [] { return nickel::wrap(name)([](counted const&) {}); };
+
+    {
+        counted value;
+        REQUIRE(counted::live == 1);
+
+        auto call = nickel::materialize(fn().name(value), arena);
+        CHECK(counted::live == 2);
+
+        auto moved = std::move(call);
+        CHECK(counted::live == 2);
+
+        std::move(moved)();
+        CHECK(counted::live == 2);
+    }
+    CHECK(counted::live == 0);
+}
+
+TEST_CASE("An exhausted arena throws std::bad_alloc")
+{
+    alignas(std::max_align_t) unsigned char buffer[sizeof(counted) + sizeof(std::string) / 2];
+    nickel::arena arena(buffer);
+
+    auto fn = [] { return nickel::wrap(name, label)([](counted const&, std::string const&) {}); };
+
+    counted value;
+    std::string const text = "text";
+    CHECK_THROWS_AS(nickel::materialize(fn().name(value).label(text), arena), std::bad_alloc);
+    // The partially materialized arguments were cleaned up.
+    CHECK(counted::live == 1);
+}
@@ -0,0 +1,160 @@
+#include <nickel/memoize.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace {
+    NICKEL_NAME(width, width);
+    NICKEL_NAME(height, height);
+    NICKEL_NAME(label, label);
+
+    int calls = 0;
+
+    auto rectangle()
+    {
+        return nickel::wrap(width, height = 1)([](int width, int height) {
+            ++calls;
+            return width * height;
+        });
+    }
+
+    int constructions = 0;
+
+    // Counts how often it is constructed from nickel::in_place(...)'s arguments.
+    struct counted_text
+    {
+        std::string text;
+
+        counted_text(std::size_t count, char c)
+            : text(count, c)
+        {
+            ++constructions;
+        }
+
+        friend bool operator==(counted_text const& lhs, counted_text const& rhs)
+        {
+            return lhs.text == rhs.text;
+        }
+    };
+}
+
+namespace std {
+    template <>
+    struct hash<counted_text>
+    {
+        std::size_t operator()(counted_text const& value) const
+        {
+            return std::hash<std::string> {}(value.text);
+        }
+    };
+}
+
+namespace {
+    auto text_length()
+    {
+        return nickel::wrap(label)([](counted_text label) {
+            ++calls;
+            return label.text.size();
+        });
+    }
+}
+
+TEST_CASE("nickel::memoize caches results by their arguments")
+{
+    calls = 0;
+    auto area = nickel::memoize(rectangle(), 16);
+
+    CHECK(area().width(2).height(3)() == 6);
+    CHECK(area().height(3).width(2)() == 6);
+    CHECK(area()(height = 3, width = 2)() == 6);
+    CHECK(calls == 1);
+
+    CHECK(area().width(2).height(4)() == 8);
+    CHECK(calls == 2);
+
+    CHECK(area.hits() == 2);
+    CHECK(area.misses() == 2);
+    CHECK(area.size() == 2);
+}
+
+TEST_CASE("nickel::memoize keys on the arguments after defaults are applied")
+{
+    calls = 0;
+    auto area = nickel::memoize(rectangle(), 16);
+
+    CHECK(area().width(5)() == 5);
+    CHECK(area().width(5).height(1)() == 5);
+    CHECK(calls == 1);
+}
+
+TEST_CASE("nickel::memoize evicts the least recently used result")
+{
+    calls = 0;
+    auto area = nickel::memoize(rectangle(), 2);
+
+    area().width(1)();
+    area().width(2)();
+    area().width(1)(); // 1 is now the most recently used
+    area().width(3)(); // evicts 2
+    CHECK(calls == 3);
+    CHECK(area.size() == 2);
+
+    area().width(1)();
+    CHECK(calls == 3);
+    area().width(2)();
+    CHECK(calls == 4);
+
+    area.clear();
+    CHECK(area.size() == 0);
+    area().width(1)();
+    CHECK(calls == 5);
+}
+
+TEST_CASE("nickel::memoize can be shared between threads")
+{
+    auto greet = nickel::memoize<std::mutex>(
+        nickel::wrap(label)([](std::string const& label) { return "Hello, " + label; }), 4);
+
+    // Catch's assertions are not thread-safe, so each thread counts its wrong results.
+    std::atomic<int> wrong {0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i != 4; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j != 100; ++j) {
+                std::string const label_value(1, static_cast<char>('a' + j % 8));
+                if (greet().label(label_value)() != "Hello, " + label_value) ++wrong;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(wrong == 0);
+    CHECK(greet.hits() + greet.misses() == 400);
+    CHECK(greet.size() == 4);
+}
+
+TEST_CASE("nickel::memoize constructs an in-place argument once")
+{
+    calls = 0;
+    constructions = 0;
+    auto length = nickel::memoize(text_length(), 4);
+
+    CHECK(length().label(nickel::in_place(3, 'a'))() == 3);
+    CHECK(constructions == 1);
+    CHECK(length().label(nickel::in_place(3, 'a'))() == 3);
+    CHECK(constructions == 2);
+    CHECK(calls == 1);
+
+    auto greet = nickel::memoize(
+        nickel::wrap(label)([](std::string label) { return "Hello, " + label; }), 4);
+    CHECK(greet().label(nickel::in_place(3, 'a'))() == "Hello, aaa");
+}
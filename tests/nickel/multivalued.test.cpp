@@ -5,10 +5,23 @@
 
 #include <nickel/nickel.hpp>
 
+#include <numeric>
+#include <string>
+#include <type_traits>
+
 #include <catch2/catch.hpp>
 
 namespace {
     NICKEL_NAME(to, to);
+    NICKEL_NAME(ids, ids);
+    NICKEL_NAME(label, label);
+
+    auto sum()
+    {
+        return nickel::wrap(ids.multivalued())([](nickel::values<int> ids) {
+            return std::accumulate(ids.begin(), ids.end(), 0);
+        });
+    }
 }
 
 TEST_CASE("Can take multiple arguments as parameters")
@@ -56,3 +69,38 @@ TEST_CASE("Can take 0 arguments as parameters")
 
     CHECK(result == 0);
 }
+
+TEST_CASE("Can take any number of arguments of one type")
+{
+    CHECK(sum().ids(4)() == 4);
+    CHECK(sum().ids(1, 2, 3)() == 6);
+    CHECK(sum().ids(1, 2, 3, 4, 5, 6, 7, 8)() == 36);
+}
+
+TEST_CASE("Dynamic multivalued arguments refer to the values")
+{
+    std::string const first = "first";
+    std::string second = "second";
+
+    auto test = [&] {
+        return nickel::wrap(label.multivalued())([&](nickel::values<std::string> label) {
+            REQUIRE(label.size() == 2);
+            CHECK(&label[0] == &first);
+            CHECK(&*(label.begin() + 1) == &second);
+            CHECK(label.end() - label.begin() == 2);
+        });
+    };
+
+    test().label(first, second)();
+}
+
+TEST_CASE("Dynamic multivalued parameters can default to no values")
+{
+    auto test = [] {
+        return nickel::wrap(ids.multivalued() = nickel::values<int> {})(
+            [](auto ids) -> decltype(ids) { return ids; });
+    };
+
+    CHECK(test()().empty());
+    CHECK((std::is_same<decltype(test()()), decltype(test().ids(1, 2)())>::value));
+}
@@ -1,6 +1,7 @@
 #include <nickel/nickel.hpp>
 
 #include <ostream>
+#include <type_traits>
 #include <utility>
 
 #include <catch2/catch.hpp>
@@ -236,3 +237,70 @@ TEST_CASE("Empty wrap is possible")
 {
     CHECK(some_other_function()() == 42);
 }
+
+namespace {
+    auto add()
+    {
+        return nickel::wrap(foo_name, bar_name)([](int foo, int bar) { return foo + bar; });
+    }
+
+    auto subtract()
+    {
+        return nickel::wrap(foo_name, bar_name)([](int foo, int bar) { return foo - bar; });
+    }
+
+    int multiply(int foo, int bar)
+    {
+        return foo * bar;
+    }
+
+    // The bound arguments of an in-progress call, as set (`bound`) and as the call lays them out
+    // (`canonical`).
+    template <typename Call>
+    struct call_storage;
+
+    template <typename Defaults, typename Storage, typename Fn, typename Kwargs, typename Names,
+        typename Policy>
+    struct call_storage<nickel::detail::wrapped_fn<Defaults, Storage, Fn, Kwargs, Names, Policy>>
+    {
+        using bound = Storage;
+        using canonical = typename nickel::detail::canonical_storage<
+            typename Kwargs::template append_names<Names>, Storage>::type;
+    };
+}
+
+TEST_CASE("Functions with the same names and signature share builder types")
+{
+    STATIC_REQUIRE(std::is_same<decltype(add()), decltype(subtract())>::value);
+    STATIC_REQUIRE(std::is_same<decltype(add().foo(1)), decltype(subtract().foo(1))>::value);
+    STATIC_REQUIRE(std::is_same<decltype(add()),
+        decltype(nickel::wrap(foo_name, bar_name)(multiply))>::value);
+
+    CHECK(add().foo(5).bar(3)() == 8);
+    CHECK(subtract().bar(3).foo(5)() == 2);
+    CHECK(nickel::wrap(foo_name, bar_name)(multiply).foo(5).bar(3)() == 15);
+}
+
+TEST_CASE("Arguments can be set in any order")
+{
+    using foo_bar = call_storage<decltype(add().foo(1).bar(2))>;
+    using bar_foo = call_storage<decltype(add().bar(2).foo(1))>;
+
+    STATIC_REQUIRE_FALSE(std::is_same<foo_bar::bound, bar_foo::bound>::value);
+    STATIC_REQUIRE(std::is_same<foo_bar::canonical, bar_foo::canonical>::value);
+    STATIC_REQUIRE(std::is_same<foo_bar::canonical, foo_bar::bound>::value);
+
+    CHECK(add().foo(1).bar(2)() == 3);
+    CHECK(add().bar(2).foo(1)() == 3);
+    CHECK(subtract()(bar_name = 2, foo_name = 1)() == -1);
+    CHECK(subtract()(foo_name = 1)(bar_name = 2)() == -1);
+}
+
+TEST_CASE("Several arguments can be given at once")
+{
+    auto const negate = [](int i) { return -i; };
+
+    CHECK(some_function()(foo_name = negate, bar_name = 1)() == -1);
+    CHECK(some_function()(bar_name = 2, foo_name = negate)() == -2);
+    CHECK(some_function().bar(3)(foo_name = negate)() == -3);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <nickel/thin.hpp>
+
+#include <string>
+
+// A function whose named interface is declared here, but which is built and defined in
+// out_of_line_definition.test.cpp.
+namespace out_of_line {
+    NICKEL_NAME(width, width);
+    NICKEL_NAME(height, height);
+    NICKEL_NAME(title, title);
+
+    std::string make_window_impl(int width, int height, std::string const& title);
+
+    using make_window_fn
+        = decltype(nickel::wrap_thin(width, height = 600, title)(make_window_impl));
+
+    make_window_fn make_window();
+}
@@ -0,0 +1,14 @@
+#include "out_of_line.hpp"
+
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+
+using namespace out_of_line;
+
+TEST_CASE("Functions can be built and defined in another translation unit")
+{
+    CHECK(make_window().title("Nickel").width(800).height(400)() == "Nickel 800x400");
+    CHECK(make_window().width(800).title("Nickel")() == "Nickel 800x600");
+    CHECK_THROWS_AS(make_window().width(800)(), std::invalid_argument);
+}
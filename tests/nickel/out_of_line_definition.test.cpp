@@ -0,0 +1,13 @@
+#include "out_of_line.hpp"
+
+namespace out_of_line {
+    std::string make_window_impl(int width, int height, std::string const& title)
+    {
+        return title + " " + std::to_string(width) + "x" + std::to_string(height);
+    }
+
+    make_window_fn make_window()
+    {
+        return nickel::wrap_thin(width, height = 600, title)(make_window_impl);
+    }
+}
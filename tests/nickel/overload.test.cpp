@@ -0,0 +1,57 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+#include <string>
+
+#include <catch2/catch.hpp>
+
+namespace {
+    NICKEL_NAME(radius, radius);
+    NICKEL_NAME(width, width);
+    NICKEL_NAME(height, height);
+    NICKEL_NAME(label, label);
+
+    auto circle_area()
+    {
+        return nickel::wrap(radius)([](double radius) { return 3 * radius * radius; });
+    }
+
+    auto rectangle_area()
+    {
+        return nickel::wrap(width, height)(
+            [](double width, double height) { return width * height; });
+    }
+
+    auto describe()
+    {
+        return nickel::overload( //
+            nickel::wrap(radius, label = std::string("circle"))(
+                [](double radius, std::string const& label) {
+                    return label + " " + std::to_string(int(radius));
+                }),
+            nickel::wrap(width, height)([](double width, double height) {
+                return "rectangle " + std::to_string(int(width)) + "x"
+                    + std::to_string(int(height));
+            }));
+    }
+}
+
+TEST_CASE("overload calls the function which takes the names which were set")
+{
+    auto area = [] { return nickel::overload(circle_area(), rectangle_area()); };
+
+    CHECK(area().radius(2)() == 12);
+    CHECK(area().width(2).height(3)() == 6);
+    CHECK(area().height(3).width(2)() == 6);
+}
+
+TEST_CASE("overload uses the chosen function's defaults")
+{
+    CHECK(describe().radius(2)() == "circle 2");
+    CHECK(describe().radius(2).label("disc")() == "disc 2");
+    CHECK(describe().width(2).height(3)() == "rectangle 2x3");
+}
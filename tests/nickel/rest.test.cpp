@@ -0,0 +1,63 @@
+#include <nickel/nickel.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+namespace {
+    NICKEL_NAME(label, label);
+    NICKEL_NAME(x, x);
+    NICKEL_NAME(y, y);
+    NICKEL_NAME(z, z);
+
+    auto point()
+    {
+        return nickel::wrap(x, y = 0, z = 0)([](int x, int y, int z) { return x + 10 * y + 100 * z; });
+    }
+
+    auto labelled_point()
+    {
+        return nickel::wrap(label, nickel::rest)([](std::string label, auto&& rest) {
+            return label + ": " + std::to_string(point()(std::forward<decltype(rest)>(rest))());
+        });
+    }
+}
+
+TEST_CASE("rest collects the arguments for undeclared names")
+{
+    CHECK(labelled_point().label("p")(x = 1)(z = 3)() == "p: 301");
+    CHECK(labelled_point()(x = 1)(y = 2).label("q")() == "q: 21");
+}
+
+TEST_CASE("rest may be empty")
+{
+    auto fn = [] {
+        return nickel::wrap(x, nickel::rest)([](int x, auto&& rest) {
+            return x + point()(std::forward<decltype(rest)>(rest)).x(1)();
+        });
+    };
+
+    CHECK(fn().x(2)() == 3);
+}
+
+TEST_CASE("(name = value) sets a declared name")
+{
+    CHECK(point()(x = 1)(y = 2)() == 21);
+    CHECK(point().z(3)(x = 1)() == 301);
+}
+
+TEST_CASE("(name = value) works with move-only values")
+{
+    auto fn = [] {
+        return nickel::wrap(label)([](std::unique_ptr<int> label) { return *label; });
+    };
+
+    CHECK(fn()(label = std::make_unique<int>(4))() == 4);
+}
+
+TEST_CASE("rest collects several arguments at once")
+{
+    CHECK(labelled_point()(label = std::string("p"), z = 3, x = 1)() == "p: 301");
+}
@@ -0,0 +1,126 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/soa.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace {
+    NICKEL_NAME(x, x);
+    NICKEL_NAME(y, y);
+    NICKEL_NAME(label, label);
+
+    struct Point
+    {
+        double x;
+        double y;
+        std::string label;
+    };
+
+    struct copy_counter
+    {
+        static int copies;
+
+        copy_counter() = default;
+
+        copy_counter(copy_counter const&)
+        {
+            ++copies;
+        }
+
+        double operator()(double x, double y) const
+        {
+            return x + y;
+        }
+    };
+
+    int copy_counter::copies = 0;
+
+    std::vector<Point> points()
+    {
+        return {
+            {1, 2, "a"},
+            {3, 4, "b"},
+            {5, 6, "c"},
+        };
+    }
+}
+
+TEST_CASE("soa builds one contiguous column per name")
+{
+    auto const objects = points();
+    auto table = nickel::soa(objects, ::x = &Point::x, ::label = &Point::label);
+
+    CHECK(table.x() == std::vector<double> {1, 3, 5});
+    CHECK(table.label() == std::vector<std::string> {"a", "b", "c"});
+}
+
+TEST_CASE("for_each_row passes each row by name")
+{
+    auto const objects = points();
+    auto const table = nickel::soa(objects, ::x = &Point::x, ::y = &Point::y);
+
+    std::vector<double> sums;
+    nickel::for_each_row(table, nickel::wrap(x, y)([&](double x, double y) {
+        sums.push_back(x + y); //
+    }));
+
+    CHECK(sums == std::vector<double> {3, 7, 11});
+}
+
+TEST_CASE("for_each_row can write to the columns")
+{
+    auto const objects = points();
+    auto table = nickel::soa(objects, ::x = &Point::x, ::y = &Point::y);
+
+    nickel::for_each_row(table, nickel::wrap(x, y)([](double& x, double y) {
+        x *= y; //
+    }));
+
+    CHECK(table.x() == std::vector<double> {2, 12, 30});
+}
+
+TEST_CASE("for_each_row uses default arguments for missing columns")
+{
+    auto const objects = points();
+    auto table = nickel::soa(objects, ::y = &Point::y);
+
+    std::vector<double> products;
+    nickel::for_each_row(table, nickel::wrap(x = 10.0, y)([&](double x, double y) {
+        products.push_back(x * y); //
+    }));
+
+    CHECK(products == std::vector<double> {20, 40, 60});
+}
+
+TEST_CASE("for_each_row copies the function once rather than per row")
+{
+    auto const objects = points();
+    auto table = nickel::soa(objects, ::x = &Point::x, ::y = &Point::y);
+    auto fn = nickel::wrap(x, y)(copy_counter {});
+
+    copy_counter::copies = 0;
+    nickel::for_each_row(table, fn);
+
+    CHECK(copy_counter::copies == 1);
+}
+
+TEST_CASE("for_each_row rejects columns of different lengths")
+{
+    auto const objects = points();
+    auto table = nickel::soa(objects, ::x = &Point::x, ::y = &Point::y);
+    table.y().pop_back();
+
+    bool called = false;
+    CHECK_THROWS_AS(nickel::for_each_row(table, nickel::wrap(x, y)([&](double, double) {
+        called = true; //
+    })),
+        std::length_error);
+    CHECK_FALSE(called);
+}
@@ -7,6 +7,9 @@
 
 #include <memory>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <catch2/catch.hpp>
@@ -71,3 +74,167 @@ TEST_CASE("Stealing a single member will unwrap the tuple")
     REQUIRE(pointer.get() == pointer_val);
     CHECK(*pointer == *pointer_val);
 }
+
+namespace {
+    struct move_counter
+    {
+        static int moves;
+        static int copies;
+
+        move_counter() = default;
+
+        move_counter(move_counter const&)
+        {
+            ++copies;
+        }
+
+        move_counter(move_counter&&)
+        {
+            ++moves;
+        }
+
+        move_counter& operator=(move_counter const&)
+        {
+            ++copies;
+            return *this;
+        }
+
+        move_counter& operator=(move_counter&&)
+        {
+            ++moves;
+            return *this;
+        }
+    };
+
+    int move_counter::moves = 0;
+    int move_counter::copies = 0;
+
+    NICKEL_NAME(first, first);
+    NICKEL_NAME(second, second);
+
+    struct Counted
+    {
+        move_counter first;
+        move_counter second;
+
+        auto steal() &&
+        {
+            return nickel::steal(std::move(*this), //
+                ::first = &Counted::first, //
+                ::second = &Counted::second);
+        }
+    };
+}
+
+TEST_CASE("Stolen members are accessible by name")
+{
+    Person person;
+    person.name = "Hello, World!";
+    person.numbers = std::vector<int> {1, 2, 3};
+
+    auto stolen = std::move(person).steal().numbers().name()();
+
+    CHECK(stolen.name() == "Hello, World!");
+    CHECK(stolen.numbers() == std::vector<int> {1, 2, 3});
+    CHECK(std::get<0>(stolen) == std::vector<int> {1, 2, 3});
+}
+
+TEST_CASE("Steal moves each member exactly once")
+{
+    Counted counted;
+    move_counter::moves = 0;
+    move_counter::copies = 0;
+
+    auto stolen = std::move(counted).steal().second().first()();
+    (void)stolen;
+
+    CHECK(move_counter::copies == 0);
+    CHECK(move_counter::moves == 2);
+}
+
+#ifdef __cpp_structured_bindings
+TEST_CASE("Stolen members can be bound with structured bindings")
+{
+    Person person;
+    person.name = "Hello, World!";
+    person.pointer = std::make_unique<int>(42);
+
+    auto [pointer, name] = std::move(person).steal().pointer().name()();
+
+    REQUIRE(pointer != nullptr);
+    CHECK(*pointer == 42);
+    CHECK(name == "Hello, World!");
+}
+#endif
+
+TEST_CASE("Members which were not stolen can be read by name")
+{
+    Person person;
+    person.name = "Hello, World!";
+    person.pointer = std::make_unique<int>(42);
+    person.numbers = std::vector<int> {1, 2, 3};
+
+    auto const numbers_data = person.numbers.data();
+
+    auto stolen = std::move(person).steal().pointer().name()();
+
+    REQUIRE(stolen.pointer() != nullptr);
+    CHECK(*stolen.pointer() == 42);
+    CHECK(stolen.name() == "Hello, World!");
+
+    // Read in place; not moved.
+    CHECK(stolen.numbers() == std::vector<int> {1, 2, 3});
+    CHECK(&stolen.numbers() == &person.numbers);
+    CHECK(person.numbers.data() == numbers_data);
+    static_assert(std::is_same<decltype(stolen.numbers()), std::vector<int> const&>::value,
+        "Members which were not stolen are read-only");
+}
+
+TEST_CASE("Stealing a single member keeps named access to the others")
+{
+    Person person;
+    person.name = "Hello, World!";
+    person.numbers = std::vector<int> {1, 2, 3};
+
+    auto const numbers_data = person.numbers.data();
+
+    auto stolen = std::move(person).steal().numbers()();
+
+    CHECK(stolen.numbers().data() == numbers_data);
+    CHECK(stolen.numbers() == std::vector<int> {1, 2, 3});
+    CHECK(&stolen.name() == &person.name);
+    CHECK(stolen.name() == "Hello, World!");
+    CHECK(std::tuple_size<decltype(stolen)>::value == 1);
+
+    std::vector<int> numbers = std::move(stolen);
+    CHECK(numbers.data() == numbers_data);
+}
+
+TEST_CASE("Stolen members outlive a temporary object")
+{
+    auto make_person = [] {
+        Person person;
+        person.name = "Hello, World!";
+        person.pointer = std::make_unique<int>(42);
+        return person;
+    };
+
+    // The temporary Person is destroyed here; only the stolen members may be used.
+    auto stolen = make_person().steal().pointer().name()();
+
+    REQUIRE(stolen.pointer() != nullptr);
+    CHECK(*stolen.pointer() == 42);
+    CHECK(stolen.name() == "Hello, World!");
+}
+
+TEST_CASE("Stealing nothing gives read access to every member")
+{
+    Person person;
+    person.name = "Hello, World!";
+
+    auto view = std::move(person).steal()();
+
+    CHECK(&view.name() == &person.name);
+    CHECK(view.name() == "Hello, World!");
+    CHECK(std::tuple_size<decltype(view)>::value == 0);
+}
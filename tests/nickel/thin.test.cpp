@@ -0,0 +1,95 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/thin.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+namespace {
+    NICKEL_NAME(x, x);
+    NICKEL_NAME(y, y);
+    NICKEL_NAME(name, name);
+    NICKEL_NAME(out, out);
+
+    auto subtract()
+    {
+        return nickel::wrap_thin(x, y)([](int x, int y) { return x - y; });
+    }
+}
+
+TEST_CASE("Thin functions can be called with names in any order")
+{
+    CHECK(subtract().x(5).y(3)() == 2);
+    CHECK(subtract().y(3).x(5)() == 2);
+}
+
+TEST_CASE("Setting an argument does not change a thin function's type")
+{
+    STATIC_REQUIRE(std::is_same<decltype(subtract()), decltype(subtract().x(5))>::value);
+    STATIC_REQUIRE(std::is_same<decltype(subtract()), decltype(subtract().y(3).x(5))>::value);
+}
+
+TEST_CASE("Thin functions use default arguments")
+{
+    int calls = 0;
+    auto fn = [&] {
+        return nickel::wrap_thin(x = 10, y = nickel::deferred([&] {
+            ++calls;
+            return 1;
+        }))([](int x, int y) { return x - y; });
+    };
+
+    CHECK(fn()() == 9);
+    CHECK(calls == 1);
+    CHECK(fn().x(5)() == 4);
+    CHECK(calls == 2);
+    CHECK(fn().y(3)() == 7);
+    CHECK(calls == 2);
+}
+
+TEST_CASE("Thin functions convert and forward their arguments")
+{
+    std::string result;
+    auto fn = [&] {
+        return nickel::wrap_thin(name, out)([&](std::string const& name, std::string& out) {
+            out = "Hello, " + name; //
+        });
+    };
+
+    fn().name("World").out(result)();
+    CHECK(result == "Hello, World");
+
+    std::string const world = "World!";
+    fn().out(result).name(world)();
+    CHECK(result == "Hello, World!");
+
+    auto take = nickel::wrap_thin(x)([](std::unique_ptr<int> x) { return *x; });
+    CHECK(std::move(take).x(std::make_unique<int>(42))() == 42);
+}
+
+TEST_CASE("Thin functions report argument errors at runtime")
+{
+    CHECK_THROWS_AS(subtract().x(5)(), std::invalid_argument);
+    CHECK_THROWS_AS(subtract().x(5).x(3), std::invalid_argument);
+}
+
+TEST_CASE("Thin mode does not change functions made with nickel::wrap")
+{
+    auto fn = [] { return nickel::wrap(x, y)([](int x, int y) { return x - y; }); };
+
+    STATIC_REQUIRE_FALSE(std::is_same<decltype(fn()), decltype(fn().x(5))>::value);
+    CHECK(fn()(x = 5, y = 3)() == 2);
+
+    auto forward = nickel::wrap(nickel::kwargs_group(x), y)([&](auto&& kwargs, int y) {
+        return fn().y(y)(std::forward<decltype(kwargs)>(kwargs))();
+    });
+    CHECK(std::move(forward).x(5).y(3)() == 2);
+}
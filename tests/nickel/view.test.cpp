@@ -0,0 +1,87 @@
+//          Copyright Justin Bassett 2019 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <nickel/nickel.hpp>
+
+#include <string>
+#include <type_traits>
+
+#include <catch2/catch.hpp>
+
+namespace {
+    NICKEL_NAME(x, x);
+    NICKEL_NAME(y, y);
+    NICKEL_NAME(label, label);
+
+    struct Point
+    {
+        double x;
+        double y;
+        std::string label;
+    };
+
+    auto describe()
+    {
+        return nickel::wrap(x, y, label = std::string("point"))(
+            [](double x, double y, std::string const& label) {
+                return label + "(" + std::to_string(int(x)) + ", " + std::to_string(int(y)) + ")";
+            });
+    }
+
+    template <typename Class>
+    auto point_view(Class& point)
+    {
+        return nickel::view(point, //
+            ::x = &Point::x, //
+            ::y = &Point::y, //
+            ::label = &Point::label);
+    }
+}
+
+TEST_CASE("view accessors refer to the members in place")
+{
+    Point point {1, 2, "p"};
+    auto view = point_view(point);
+
+    CHECK(&view.x() == &point.x);
+    CHECK(&view.y() == &point.y);
+    CHECK(&view.label() == &point.label);
+
+    view.x() = 10;
+    CHECK(point.x == 10);
+}
+
+TEST_CASE("view of a const object is read-only")
+{
+    Point const point {1, 2, "p"};
+    auto view = point_view(point);
+
+    STATIC_REQUIRE(std::is_same<decltype(view.x()), double const&>::value);
+    CHECK(&view.label() == &point.label);
+}
+
+TEST_CASE("view can be passed to a nickel-wrapped function")
+{
+    Point point {1, 2, "p"};
+
+    CHECK(describe()(point_view(point))() == "p(1, 2)");
+
+    auto view = nickel::view(point, ::x = &Point::x, ::y = &Point::y);
+    CHECK(describe()(view)() == "point(1, 2)");
+    CHECK(describe()(view).label("q")() == "q(1, 2)");
+}
+
+TEST_CASE("A function can modify members through a view")
+{
+    Point point {1, 2, "p"};
+
+    nickel::wrap(x, y)([](double& x, double& y) {
+        x *= 10;
+        y *= 10;
+    })(nickel::view(point, ::x = &Point::x, ::y = &Point::y))();
+
+    CHECK(point.x == 10);
+    CHECK(point.y == 20);
+}